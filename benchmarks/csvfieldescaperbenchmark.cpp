@@ -0,0 +1,129 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+/*
+ * Measures CsvFieldEscaper on multi megabyte fields.
+ * "scan" only runs NeedsQuoting, "write" runs the full Write into a BufferedFileWriter on the null device,
+ * so it includes copying into the writer's buffer but no disk I/O. Each case reports its best of several runs.
+ * The memchr baseline searches the clean field for a single character, as a ceiling for the four character scan.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "../src/services/bufferedfilewriter.h"
+#include "../src/services/csvfieldescaper.h"
+
+namespace
+{
+#ifdef _WIN32
+const char* NullDevice = "NUL";
+#else
+const char* NullDevice = "/dev/null";
+#endif
+
+constexpr std::size_t FieldSize = 8 * 1024 * 1024;
+constexpr int Iterations = 50;
+constexpr int Runs = 5;
+
+/* Keeps the compiler from dropping a scan whose result is otherwise unused */
+volatile bool gSink = false;
+
+template<typename Function>
+double BestGigabytesPerSecond(std::size_t bytesPerIteration, Function function)
+{
+    double best = 0.0;
+    for (int run = 0; run < Runs; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Iterations; i++) {
+            function();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double gigabytes = static_cast<double>(bytesPerIteration) * Iterations / (1024.0 * 1024.0 * 1024.0);
+        best = std::max(best, gigabytes / elapsed.count());
+    }
+    return best;
+}
+
+void Measure(const char* name, const std::string& field, bool measureScan)
+{
+    app::svc::CsvFieldEscaper escaper(',');
+
+    double scan = 0.0;
+    if (measureScan) {
+        scan = BestGigabytesPerSecond(field.size(), [&]() {
+            gSink = escaper.NeedsQuoting(field.data(), field.size());
+        });
+    }
+
+    app::svc::BufferedFileWriter writer(NullDevice);
+    if (!writer.Open()) {
+        std::fprintf(stderr, "Failed to open %s\n", NullDevice);
+        return;
+    }
+    double write = BestGigabytesPerSecond(field.size(), [&]() {
+        escaper.Write(writer, field.data(), field.size());
+    });
+    writer.Close();
+
+    if (measureScan) {
+        std::printf("%-24s scan %6.2f GB/s   write %6.2f GB/s\n", name, scan, write);
+    } else {
+        std::printf("%-24s scan      -          write %6.2f GB/s\n", name, write);
+    }
+}
+
+void MeasureMemchr(const char* name, const std::string& field)
+{
+    double scan = BestGigabytesPerSecond(field.size(), [&]() {
+        gSink = std::memchr(field.data(), ',', field.size()) != nullptr;
+    });
+
+    std::printf("%-24s scan %6.2f GB/s\n", name, scan);
+}
+} // namespace
+
+int main()
+{
+    std::string clean(FieldSize, 'a');
+    for (std::size_t i = 0; i < clean.size(); i++) {
+        clean[i] = static_cast<char>('a' + i % 26);
+    }
+
+    /* the first quote ends the scan at byte 0, so only the quoted write is measured for this field */
+    std::string quoteEvery4K = clean;
+    for (std::size_t i = 0; i < quoteEvery4K.size(); i += 4096) {
+        quoteEvery4K[i] = '"';
+    }
+
+    std::string delimiterAtEnd = clean;
+    delimiterAtEnd.back() = ',';
+
+    std::printf("%zu byte field, %d iterations, best of %d runs\n", FieldSize, Iterations, Runs);
+    MeasureMemchr("memchr baseline, clean", clean);
+    Measure("clean", clean, true);
+    Measure("delimiter in last byte", delimiterAtEnd, true);
+    Measure("quote every 4 KB", quoteEvery4K, false);
+
+    return 0;
+}
@@ -130,3 +130,12 @@ CREATE TABLE task_items
     FOREIGN KEY (category_id) REFERENCES categories(category_id),
     FOREIGN KEY (meeting_id) REFERENCES meetings(meeting_id)
 );
+
+CREATE INDEX idx_task_items_date_modified ON task_items(date_modified);
+
+CREATE TABLE export_watermarks
+(
+    name TEXT PRIMARY KEY NOT NULL,
+    watermark INTEGER NOT NULL,
+    date_modified INTEGER NOT NULL DEFAULT (strftime('%s','now'))
+);
@@ -20,10 +20,12 @@
 #include "application.h"
 
 #include <algorithm>
+#include <cstdio>
 
 #include <wx/file.h>
 #include <wx/stdpaths.h>
 #include <wx/msw/registry.h>
+#include <wx/filename.h>
 
 #include "common/common.h"
 #include "common/constants.h"
@@ -47,6 +49,16 @@ Application::Application()
 
 bool Application::OnInit()
 {
+    /* Parses the command line through OnInitCmdLine and OnCmdLineParsed */
+    if (!wxApp::OnInit()) {
+        return false;
+    }
+
+    /* A command runs headless and exits, so it skips the single instance check and never creates a window */
+    if (mCommandLineOptions.Command != svc::CommandLineCommand::None) {
+        return RunCommandLine();
+    }
+
 #ifndef TASKABLE_DEBUG
     bool isInstanceAlreadyRunning = pInstanceChecker->IsAnotherRunning();
     if (isInstanceAlreadyRunning) {
@@ -60,10 +72,12 @@ bool Application::OnInit()
     if (!InitializeLogging()) {
         return false;
     }
+    mStartupTimer.Mark("logging");
 
     if (!ConfigurationFileExists()) {
         return false;
     }
+    mStartupTimer.Mark("configuration");
 
     if (IsSetup()) {
         if (!StartupInitialization()) {
@@ -74,15 +88,146 @@ bool Application::OnInit()
             return false;
         }
     }
+    mStartupTimer.Mark("database");
 
     auto frame = new frm::MainFrame(pLogger);
     frame->CreateFrame();
+    mStartupTimer.Mark("frame");
+
     frame->Show(true);
+    frame->Update();
     SetTopWindow(frame);
+    mStartupTimer.Mark("first paint");
+
+    /* Everything the empty window does not need waits until it is on screen */
+    CallAfter([this, frame]() {
+        frame->LoadStartupData();
+        mStartupTimer.Mark("task items");
+        pLogger->info("Startup phases: {0}", mStartupTimer.ToString());
+
+        frame->StartBackgroundStartupTasks();
+        frame->WatchConfigFile();
+    });
 
     return true;
 }
 
+void Application::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    wxApp::OnInitCmdLine(parser);
+
+    // clang-format off
+    static const wxCmdLineEntryDesc CommandLineDescription[] = {
+        { wxCMD_LINE_SWITCH, nullptr, "export", "export task items for a date range to a file and exit" },
+        { wxCMD_LINE_SWITCH, nullptr, "report", "write day, project and category totals for a date range to a file and exit" },
+        { wxCMD_LINE_SWITCH, nullptr, "backup", "back up the database and exit" },
+        { wxCMD_LINE_OPTION, nullptr, "from", "first date to include (YYYY-MM-DD)" },
+        { wxCMD_LINE_OPTION, nullptr, "to", "last date to include (YYYY-MM-DD)" },
+        { wxCMD_LINE_OPTION, nullptr, "output", "file to write, defaults to the configured export path" },
+        { wxCMD_LINE_OPTION, nullptr, "format", "export format: csv (default) or jsonl" },
+        { wxCMD_LINE_OPTION, nullptr, "delimiter", "CSV delimiter, defaults to the configured delimiter" },
+        { wxCMD_LINE_SWITCH, nullptr, "delta", "export only task items changed since the last delta export" },
+        { wxCMD_LINE_SWITCH, nullptr, "gzip", "compress the export with gzip" },
+        { wxCMD_LINE_SWITCH, nullptr, "partitioned", "export months in parallel, one file per month" },
+        { wxCMD_LINE_SWITCH, nullptr, "combine", "combine the exported months into one file" },
+        { wxCMD_LINE_NONE }
+    };
+    // clang-format on
+
+    parser.SetDesc(CommandLineDescription);
+}
+
+bool Application::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    if (!wxApp::OnCmdLineParsed(parser)) {
+        return false;
+    }
+
+    int commands = 0;
+    if (parser.Found(wxT("export"))) {
+        mCommandLineOptions.Command = svc::CommandLineCommand::Export;
+        commands++;
+    }
+    if (parser.Found(wxT("report"))) {
+        mCommandLineOptions.Command = svc::CommandLineCommand::Report;
+        commands++;
+    }
+    if (parser.Found(wxT("backup"))) {
+        mCommandLineOptions.Command = svc::CommandLineCommand::Backup;
+        commands++;
+    }
+
+    if (commands == 0) {
+        return true;
+    }
+
+    AttachParentConsole();
+
+    if (commands > 1) {
+        std::fprintf(stderr, "Only one of --export, --report and --backup can be given\n");
+        SetErrorExitCode(svc::ExitUsageError);
+        return false;
+    }
+
+    auto& options = mCommandLineOptions.Export;
+
+    wxString value;
+    if (parser.Found(wxT("from"), &value)) {
+        options.FromDate = value.ToStdString();
+    }
+    if (parser.Found(wxT("to"), &value)) {
+        options.ToDate = value.ToStdString();
+    }
+    if (parser.Found(wxT("output"), &value)) {
+        options.FilePath = value.ToStdString();
+    }
+    if (parser.Found(wxT("format"), &value)) {
+        if (value.IsSameAs(wxT("jsonl"), false)) {
+            options.Format = svc::ExportFormat::JsonLines;
+        } else if (!value.IsSameAs(wxT("csv"), false)) {
+            std::fprintf(stderr, "Unknown export format \"%s\", expected csv or jsonl\n", value.ToStdString().c_str());
+            SetErrorExitCode(svc::ExitUsageError);
+            return false;
+        }
+    }
+    if (parser.Found(wxT("delimiter"), &value)) {
+        mCommandLineOptions.Delimiter = value.ToStdString();
+    }
+
+    options.Delta = parser.Found(wxT("delta"));
+    options.Compressed = parser.Found(wxT("gzip"));
+    options.Partitioned = !options.Delta && parser.Found(wxT("partitioned"));
+    options.CombinePartitions = parser.Found(wxT("combine"));
+
+    bool needsDates = mCommandLineOptions.Command == svc::CommandLineCommand::Report ||
+                      (mCommandLineOptions.Command == svc::CommandLineCommand::Export && !options.Delta);
+    if (needsDates && (options.FromDate.empty() || options.ToDate.empty())) {
+        std::fprintf(stderr, "--from and --to are required\n");
+        SetErrorExitCode(svc::ExitUsageError);
+        return false;
+    }
+
+    return true;
+}
+
+bool Application::OnCmdLineError(wxCmdLineParser& parser)
+{
+    AttachParentConsole();
+    std::fprintf(stderr, "%s", parser.GetUsageString().ToStdString().c_str());
+    SetErrorExitCode(svc::ExitUsageError);
+
+    return false;
+}
+
+bool Application::OnCmdLineHelp(wxCmdLineParser& parser)
+{
+    AttachParentConsole();
+    std::fprintf(stdout, "%s", parser.GetUsageString().ToStdString().c_str());
+    SetErrorExitCode(svc::ExitSuccess);
+
+    return false;
+}
+
 bool Application::FirstStartupInitialization()
 {
     if (!CreateDatabaseFile()) {
@@ -154,16 +299,17 @@ bool Application::InitializeLogging()
 #endif // TASKABLE_DEBUG
 
     try {
-        auto msvcSink = std::make_shared<spdlog::sinks::msvc_sink_st>();
+        auto msvcSink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
 
         auto msvcLogger = std::make_shared<spdlog::logger>("msvc", msvcSink);
         msvcLogger->set_level(spdlog::level::debug);
         spdlog::register_logger(msvcLogger);
 
-        auto dialySink = std::make_shared<spdlog::sinks::daily_file_sink_st>(logDirectory, 23, 59);
-        dialySink->set_level(spdlog::level::err);
+        auto dialySink = std::make_shared<spdlog::sinks::daily_file_sink_mt>(logDirectory, 23, 59);
+        /* info keeps the startup timing and backup results in the file, which are written a handful of times a day */
+        dialySink->set_level(spdlog::level::info);
 
-        auto combinedLoggers = std::make_shared<spdlog::sinks::dist_sink_st>();
+        auto combinedLoggers = std::make_shared<spdlog::sinks::dist_sink_mt>();
         combinedLoggers->add_sink(msvcSink);
         combinedLoggers->add_sink(dialySink);
         pLogger = std::make_shared<spdlog::logger>(LoggerName, combinedLoggers);
@@ -285,7 +431,7 @@ bool Application::ConfigurationFileExists()
             wxStandardPaths::Get().GetAppDocumentsDir().ToStdString());
 #endif // TASKABLE_DEBUG
 
-        cfg::ConfigurationProvider::Get().Configuration->Save();
+        cfg::ConfigurationProvider::Get().Configuration->Flush();
     }
 
     return configFileExists;
@@ -428,6 +574,100 @@ bool Application::InitializeDatabaseTables()
     svc::SetupTables tables(pLogger);
     return tables.CreateTables();
 }
+
+bool Application::RunCommandLine()
+{
+    /* The exit code is reported through wxEntry, which uses it when OnInit fails */
+    SetErrorExitCode(svc::ExitNotReady);
+
+    if (!InitializeLogging()) {
+        std::fprintf(stderr, "Unable to initialize logging\n");
+        return false;
+    }
+
+    if (!wxFileExists(common::GetConfigFilePath())) {
+        std::fprintf(stderr, "Unable to locate the configuration file at %s\n",
+            common::GetConfigFilePath().ToStdString().c_str());
+        return false;
+    }
+
+    cfg::ConfigurationProvider::Get().Initialize();
+
+    /* Setup, a missing database and pending upgrades all need the wizards, so they are left to an interactive start */
+    if (!IsSetup() || CheckForDatabaseUpgrade()) {
+        std::fprintf(stderr, "%s must be started normally once before it can be run from the command line\n",
+            common::GetProgramName().ToStdString().c_str());
+        return false;
+    }
+
+    auto databaseFilePath =
+        common::GetDatabaseFilePath(cfg::ConfigurationProvider::Get().Configuration->GetDatabasePath());
+    if (!wxFileExists(databaseFilePath)) {
+        std::fprintf(stderr, "Unable to locate the database file at %s\n", databaseFilePath.ToStdString().c_str());
+        return false;
+    }
+
+    InitializeDatabaseConnectionProvider();
+
+    /* Anything not given on the command line falls back to the same settings the export dialog uses */
+    const auto& configuration = cfg::ConfigurationProvider::Get().Configuration;
+    auto& options = mCommandLineOptions.Export;
+
+    auto delimiter =
+        mCommandLineOptions.Delimiter.empty() ? configuration->GetDelimiter() : mCommandLineOptions.Delimiter;
+    if (delimiter == "\\t") {
+        options.Delimiter = '\t';
+    } else if (!delimiter.empty()) {
+        options.Delimiter = delimiter[0];
+    }
+    options.CompressionLevel = configuration->GetCompressionLevel();
+    options.Columns = configuration->GetExportColumns();
+
+    if (options.FilePath.empty()) {
+        wxString extension = options.Format == svc::ExportFormat::JsonLines ? wxT(".jsonl") : wxT(".csv");
+        if (options.Compressed) {
+            extension += wxT(".gz");
+        }
+
+        wxString fileName;
+        if (mCommandLineOptions.Command == svc::CommandLineCommand::Report) {
+            fileName = "Taskable_Report_" + options.FromDate + "_" + options.ToDate + ".csv";
+        } else if (options.Delta) {
+            fileName = "Taskable_Delta_" + wxDateTime::Now().Format("%Y-%m-%dT%H%M%S") + extension;
+        } else {
+            fileName = "Taskable_Export_" + options.FromDate + "_" + options.ToDate + extension;
+        }
+
+        wxString exportPath = configuration->GetExportPath().empty() ? wxStandardPaths::Get().GetDocumentsDir()
+                                                                     : wxString(configuration->GetExportPath());
+        options.FilePath = wxFileName(exportPath, fileName).GetFullPath().ToStdString();
+    }
+
+    svc::CommandLineRunner commandLineRunner(pLogger);
+    int exitCode = commandLineRunner.Run(mCommandLineOptions);
+
+    db::ConnectionProvider::Get().PurgeConnectionPool();
+
+    /* Returning false ends the application before the main loop starts, with exitCode as the process exit code */
+    SetErrorExitCode(exitCode);
+    return false;
+}
+
+void Application::AttachParentConsole()
+{
+    static bool attached = false;
+    if (attached) {
+        return;
+    }
+    attached = true;
+
+    /* Taskable is a GUI subsystem executable, so output only reaches a console it was started from once attached */
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        FILE* stream = nullptr;
+        freopen_s(&stream, "CONOUT$", "w", stdout);
+        freopen_s(&stream, "CONOUT$", "w", stderr);
+    }
+}
 } // namespace app
 
 wxIMPLEMENT_APP(app::Application);
@@ -23,12 +23,16 @@
 
 #include <wx/wx.h>
 #include <wx/snglinst.h>
+#include <wx/cmdline.h>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/dist_sink.h>
 #include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
+#include "common/phasetimer.h"
+#include "services/commandlinerunner.h"
+
 namespace app
 {
 class Application : public wxApp
@@ -39,6 +43,11 @@ class Application : public wxApp
 
     bool OnInit() override;
 
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+    bool OnCmdLineError(wxCmdLineParser& parser) override;
+    bool OnCmdLineHelp(wxCmdLineParser& parser) override;
+
 private:
     bool FirstStartupInitialization();
     bool StartupInitialization();
@@ -64,7 +73,12 @@ class Application : public wxApp
 
     bool InitializeDatabaseTables();
 
+    bool RunCommandLine();
+    void AttachParentConsole();
+
     std::shared_ptr<spdlog::logger> pLogger;
     std::unique_ptr<wxSingleInstanceChecker> pInstanceChecker;
+    svc::CommandLineOptions mCommandLineOptions;
+    common::PhaseTimer mStartupTimer;
 };
 } // namespace app
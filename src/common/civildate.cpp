@@ -0,0 +1,75 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "civildate.h"
+
+#include <wx/datetime.h>
+#include <wx/string.h>
+
+namespace app::common
+{
+CivilDate CivilDate::Parse(const std::string& value)
+{
+    CivilDate date;
+    TryParse(value.data(), value.size(), date);
+    return date;
+}
+
+CivilDate CivilDate::Parse(const wxString& value)
+{
+    CivilDate date;
+    TryParse(value.wx_str(), value.length(), date);
+    return date;
+}
+
+CivilDate CivilDate::FromDateTime(const wxDateTime& value)
+{
+    /* wxDateTime months are zero based */
+    return FromYearMonthDay(value.GetYear(), static_cast<int>(value.GetMonth()) + 1, value.GetDay());
+}
+
+CivilDate CivilDate::Today()
+{
+    return FromDateTime(wxDateTime::Today());
+}
+
+wxDateTime CivilDate::ToDateTime() const
+{
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    ToYearMonthDay(year, month, day);
+
+    return wxDateTime(static_cast<wxDateTime::wxDateTime_t>(day), static_cast<wxDateTime::Month>(month - 1), year);
+}
+
+std::string CivilDate::ToStdString() const
+{
+    char buffer[ISODateLength];
+    std::size_t length = FormatISODate(buffer);
+    return std::string(buffer, length);
+}
+
+wxString CivilDate::FormatISODate() const
+{
+    char buffer[ISODateLength];
+    std::size_t length = FormatISODate(buffer);
+    return wxString::FromAscii(buffer, length);
+}
+} // namespace app::common
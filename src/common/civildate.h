@@ -0,0 +1,271 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+class wxDateTime;
+class wxString;
+
+namespace app::common
+{
+/*
+ * Calendar date without a time or time zone, stored as the number of days since 1970-01-01.
+ * Week arithmetic is plain integer math and ISO formatting writes into a caller supplied buffer,
+ * so the value can be copied around and used as a key without touching wxDateTime or the heap.
+ */
+class CivilDate final
+{
+public:
+    /* "YYYY-MM-DD" plus the terminator */
+    static constexpr std::size_t ISODateLength = 11;
+
+    constexpr CivilDate()
+        : mDays(0)
+    {
+    }
+
+    constexpr explicit CivilDate(int daysSinceEpoch)
+        : mDays(daysSinceEpoch)
+    {
+    }
+
+    /* Proleptic Gregorian conversion from Howard Hinnant's days_from_civil */
+    static constexpr CivilDate FromYearMonthDay(int year, int month, int day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        int era = (year >= 0 ? year : year - 399) / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return CivilDate(era * 146097 + dayOfEra - 719468);
+    }
+
+    /* Accepts exactly YYYY-MM-DD, the format of every date column in the database */
+    template<typename CharT>
+    static constexpr bool TryParse(const CharT* value, std::size_t length, CivilDate& date)
+    {
+        if (length != ISODateLength - 1 || value[4] != '-' || value[7] != '-') {
+            return false;
+        }
+
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        if (!ParseDigits(value, 4, year) || !ParseDigits(value + 5, 2, month) || !ParseDigits(value + 8, 2, day)) {
+            return false;
+        }
+
+        if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month)) {
+            return false;
+        }
+
+        date = FromYearMonthDay(year, month, day);
+        return true;
+    }
+
+    /* Returns the epoch date when the value is malformed */
+    static CivilDate Parse(const std::string& value);
+    static CivilDate Parse(const wxString& value);
+
+    static CivilDate FromDateTime(const wxDateTime& value);
+    static CivilDate Today();
+
+    wxDateTime ToDateTime() const;
+
+    constexpr int GetDaysSinceEpoch() const
+    {
+        return mDays;
+    }
+
+    constexpr int GetYear() const
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        ToYearMonthDay(year, month, day);
+        return year;
+    }
+
+    constexpr int GetMonth() const
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        ToYearMonthDay(year, month, day);
+        return month;
+    }
+
+    constexpr int GetDay() const
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        ToYearMonthDay(year, month, day);
+        return day;
+    }
+
+    /* Monday is 0 and Sunday is 6, matching constants::Days */
+    constexpr int GetDayOfWeek() const
+    {
+        /* 1970-01-01 was a Thursday */
+        int dayOfWeek = (mDays + 3) % 7;
+        return dayOfWeek < 0 ? dayOfWeek + 7 : dayOfWeek;
+    }
+
+    constexpr CivilDate GetMonday() const
+    {
+        return CivilDate(mDays - GetDayOfWeek());
+    }
+
+    constexpr CivilDate AddDays(int days) const
+    {
+        return CivilDate(mDays + days);
+    }
+
+    constexpr CivilDate AddWeeks(int weeks) const
+    {
+        return CivilDate(mDays + weeks * 7);
+    }
+
+    /* Writes YYYY-MM-DD and returns the length, excluding the terminator */
+    constexpr std::size_t FormatISODate(char (&buffer)[ISODateLength]) const
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        ToYearMonthDay(year, month, day);
+
+        buffer[0] = static_cast<char>('0' + (year / 1000) % 10);
+        buffer[1] = static_cast<char>('0' + (year / 100) % 10);
+        buffer[2] = static_cast<char>('0' + (year / 10) % 10);
+        buffer[3] = static_cast<char>('0' + year % 10);
+        buffer[4] = '-';
+        buffer[5] = static_cast<char>('0' + month / 10);
+        buffer[6] = static_cast<char>('0' + month % 10);
+        buffer[7] = '-';
+        buffer[8] = static_cast<char>('0' + day / 10);
+        buffer[9] = static_cast<char>('0' + day % 10);
+        buffer[10] = '\0';
+
+        return ISODateLength - 1;
+    }
+
+    /* Short enough for the small string buffer, so binding a date parameter does not allocate */
+    std::string ToStdString() const;
+    wxString FormatISODate() const;
+
+    friend constexpr int operator-(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays - rhs.mDays;
+    }
+
+    friend constexpr bool operator==(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays == rhs.mDays;
+    }
+
+    friend constexpr bool operator!=(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays != rhs.mDays;
+    }
+
+    friend constexpr bool operator<(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays < rhs.mDays;
+    }
+
+    friend constexpr bool operator<=(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays <= rhs.mDays;
+    }
+
+    friend constexpr bool operator>(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays > rhs.mDays;
+    }
+
+    friend constexpr bool operator>=(CivilDate lhs, CivilDate rhs)
+    {
+        return lhs.mDays >= rhs.mDays;
+    }
+
+private:
+    /* Inverse of FromYearMonthDay, Howard Hinnant's civil_from_days */
+    constexpr void ToYearMonthDay(int& year, int& month, int& day) const
+    {
+        int days = mDays + 719468;
+        int era = (days >= 0 ? days : days - 146096) / 146097;
+        int dayOfEra = days - era * 146097;
+        int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int monthPosition = (5 * dayOfYear + 2) / 153;
+
+        day = dayOfYear - (153 * monthPosition + 2) / 5 + 1;
+        month = monthPosition < 10 ? monthPosition + 3 : monthPosition - 9;
+        year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    }
+
+    static constexpr int DaysInMonth(int year, int month)
+    {
+        if (month == 2) {
+            bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+            return leapYear ? 29 : 28;
+        }
+
+        return month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31;
+    }
+
+    template<typename CharT>
+    static constexpr bool ParseDigits(const CharT* value, std::size_t count, int& result)
+    {
+        result = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            if (value[i] < '0' || value[i] > '9') {
+                return false;
+            }
+            result = result * 10 + (value[i] - '0');
+        }
+
+        return true;
+    }
+
+    int mDays;
+};
+
+static_assert(std::is_trivially_copyable<CivilDate>::value);
+static_assert(CivilDate::FromYearMonthDay(1970, 1, 1).GetDaysSinceEpoch() == 0);
+static_assert(CivilDate::FromYearMonthDay(2020, 3, 1).GetDayOfWeek() == 6);
+static_assert(CivilDate::FromYearMonthDay(2020, 2, 29).AddDays(1).GetMonth() == 3);
+} // namespace app::common
+
+namespace std
+{
+template<>
+struct hash<app::common::CivilDate> {
+    std::size_t operator()(app::common::CivilDate date) const noexcept
+    {
+        return std::hash<int>()(date.GetDaysSinceEpoch());
+    }
+};
+} // namespace std
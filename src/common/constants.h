@@ -25,7 +25,7 @@
 
 namespace app::constants
 {
-static const char* TotalHours = "Total Hours %H:%M:%S";
+static const char* TotalHours = "Total Hours %s";
 
 static const int MinLength = 2;
 static const int MinLength2 = 4;
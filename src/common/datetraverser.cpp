@@ -19,172 +19,52 @@
 
 #include "datetraverser.h"
 
-#include <algorithm>
-
 namespace app
 {
 DateTraverser::DateTraverser()
-    : mDaysToGoBackToMonday(-1)
-    , mCurrentDate(wxDateTime::Now())
-{
-    std::fill(mDates.begin(), mDates.end(), wxDateTime::Now());
-
-    CalculateMondayFromCurrentDate();
-    CalculateTuesdayDate();
-    CalculateWednesdayDate();
-    CalculateThursdayDate();
-    CalculateFridayDate();
-    CalculateSaturdayDate();
-    CalculateSundayDate();
-}
-
-void DateTraverser::Recalculate(wxDateTime newDate)
-{
-    std::fill(mDates.begin(), mDates.end(), wxDefaultDateTime);
-    std::fill(mDateStrings.begin(), mDateStrings.end(), wxGetEmptyString());
-
-    mCurrentDate = newDate;
-
-    std::fill(mDates.begin(), mDates.end(), newDate);
-
-    CalculateMondayFromCurrentDate();
-    CalculateTuesdayDate();
-    CalculateWednesdayDate();
-    CalculateThursdayDate();
-    CalculateFridayDate();
-    CalculateSaturdayDate();
-    CalculateSundayDate();
-}
-
-const wxDateTime DateTraverser::GetMondayDate()
+    : DateTraverser(common::CivilDate::Today())
 {
-    return mDates[constants::Days::Monday];
 }
 
-const wxDateTime DateTraverser::GetTuesdayDate()
+DateTraverser::DateTraverser(common::CivilDate date)
+    : mDates()
+    , mDateStrings()
 {
-    return mDates[constants::Days::Tuesday];
+    Recalculate(date);
 }
 
-const wxDateTime DateTraverser::GetWednesdayDate()
+void DateTraverser::Recalculate(common::CivilDate newDate)
 {
-    return mDates[constants::Days::Wednesday];
-}
+    common::CivilDate monday = newDate.GetMonday();
 
-const wxDateTime DateTraverser::GetThursdayDate()
-{
-    return mDates[constants::Days::Thursday];
-}
-
-const wxDateTime DateTraverser::GetFridayDate()
-{
-    return mDates[constants::Days::Friday];
-}
-
-const wxDateTime DateTraverser::GetSaturdayDate()
-{
-    return mDates[constants::Days::Saturday];
-}
-
-const wxDateTime DateTraverser::GetSundayDate()
-{
-    return mDates[constants::Days::Sunday];
-}
-
-const std::array<wxString, 7> DateTraverser::GetISODates()
-{
-    return mDateStrings;
-}
-
-const wxDateTime DateTraverser::GetDayDate(constants::Days index)
-{
-    return mDates[index];
-}
-
-const wxString DateTraverser::GetDayISODate(constants::Days index)
-{
-    return mDateStrings[index];
-}
-
-void DateTraverser::CalculateDayPosition()
-{
-    wxDateTime::WeekDay weekDay = mCurrentDate.GetWeekDay();
-    switch (weekDay) {
-    case wxDateTime::Mon:
-        mDaysToGoBackToMonday = 0;
-        break;
-    case wxDateTime::Tue:
-        mDaysToGoBackToMonday = 1;
-        break;
-    case wxDateTime::Wed:
-        mDaysToGoBackToMonday = 2;
-        break;
-    case wxDateTime::Thu:
-        mDaysToGoBackToMonday = 3;
-        break;
-    case wxDateTime::Fri:
-        mDaysToGoBackToMonday = 4;
-        break;
-    case wxDateTime::Sat:
-        mDaysToGoBackToMonday = 5;
-        break;
-    case wxDateTime::Sun:
-        mDaysToGoBackToMonday = 6;
-        break;
-    case wxDateTime::Inv_WeekDay:
-    default:
-        break;
+    for (int i = 0; i < static_cast<int>(mDates.size()); i++) {
+        mDates[i] = monday.AddDays(i);
+        mDates[i].FormatISODate(mDateStrings[i]);
     }
 }
 
-void DateTraverser::CalculateMondayFromCurrentDate()
-{
-    CalculateDayPosition();
-
-    wxDateSpan toGoBackToMonday(0, 0, 0, mDaysToGoBackToMonday);
-    mDates[constants::Days::Monday] = mDates[constants::Days::Monday].Subtract(toGoBackToMonday);
-    mDateStrings[constants::Days::Monday] = mDates[constants::Days::Monday].FormatISODate();
-}
-
-void DateTraverser::CalculateTuesdayDate()
+void DateTraverser::Recalculate(const wxDateTime& newDate)
 {
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Tuesday] = mDates[constants::Days::Monday].Add(dateSpan);
-    mDateStrings[constants::Days::Tuesday] = mDates[constants::Days::Tuesday].FormatISODate();
+    Recalculate(common::CivilDate::FromDateTime(newDate));
 }
 
-void DateTraverser::CalculateWednesdayDate()
+const std::array<common::CivilDate, 7>& DateTraverser::GetDates() const
 {
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Wednesday] = mDates[constants::Days::Tuesday].Add(dateSpan);
-    mDateStrings[constants::Days::Wednesday] = mDates[constants::Days::Wednesday].FormatISODate();
+    return mDates;
 }
 
-void DateTraverser::CalculateThursdayDate()
+common::CivilDate DateTraverser::GetDay(constants::Days index) const
 {
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Thursday] = mDates[constants::Days::Wednesday].Add(dateSpan);
-    mDateStrings[constants::Days::Thursday] = mDates[constants::Days::Thursday].FormatISODate();
-}
-
-void DateTraverser::CalculateFridayDate()
-{
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Friday] = mDates[constants::Days::Thursday].Add(dateSpan);
-    mDateStrings[constants::Days::Friday] = mDates[constants::Days::Friday].FormatISODate();
+    return mDates[index];
 }
 
-void DateTraverser::CalculateSaturdayDate()
+const wxDateTime DateTraverser::GetDayDate(constants::Days index) const
 {
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Saturday] = mDates[constants::Days::Friday].Add(dateSpan);
-    mDateStrings[constants::Days::Saturday] = mDates[constants::Days::Saturday].FormatISODate();
+    return mDates[index].ToDateTime();
 }
 
-void DateTraverser::CalculateSundayDate()
+const char* DateTraverser::GetDayISODate(constants::Days index) const
 {
-    wxDateSpan dateSpan(0, 0, 0, 1);
-    mDates[constants::Days::Sunday] = mDates[constants::Days::Saturday].Add(dateSpan);
-    mDateStrings[constants::Days::Sunday] = mDates[constants::Days::Sunday].FormatISODate();
+    return mDateStrings[index];
 }
 } // namespace app
@@ -22,47 +22,31 @@
 #include <array>
 
 #include <wx/datetime.h>
-#include <wx/string.h>
 
+#include "civildate.h"
 #include "constants.h"
 
 namespace app
 {
+/* Monday to Sunday of the week containing a date, with each day's ISO string formatted once per recalculation */
 class DateTraverser final
 {
 public:
     DateTraverser();
+    explicit DateTraverser(common::CivilDate date);
     ~DateTraverser() = default;
 
-    void Recalculate(wxDateTime newDate);
+    void Recalculate(common::CivilDate newDate);
+    void Recalculate(const wxDateTime& newDate);
 
-    const wxDateTime GetMondayDate();
-    const wxDateTime GetTuesdayDate();
-    const wxDateTime GetWednesdayDate();
-    const wxDateTime GetThursdayDate();
-    const wxDateTime GetFridayDate();
-    const wxDateTime GetSaturdayDate();
-    const wxDateTime GetSundayDate();
+    const std::array<common::CivilDate, 7>& GetDates() const;
 
-    const std::array<wxString, 7> GetISODates();
-
-    const wxDateTime GetDayDate(constants::Days index);
-    const wxString GetDayISODate(constants::Days index);
+    common::CivilDate GetDay(constants::Days index) const;
+    const wxDateTime GetDayDate(constants::Days index) const;
+    const char* GetDayISODate(constants::Days index) const;
 
 private:
-    void CalculateDayPosition();
-    void CalculateMondayFromCurrentDate();
-    void CalculateTuesdayDate();
-    void CalculateWednesdayDate();
-    void CalculateThursdayDate();
-    void CalculateFridayDate();
-    void CalculateSaturdayDate();
-    void CalculateSundayDate();
-
-    int mDaysToGoBackToMonday;
-    wxDateTime mCurrentDate;
-
-    std::array<wxDateTime, 7> mDates;
-    std::array<wxString, 7> mDateStrings;
+    std::array<common::CivilDate, 7> mDates;
+    char mDateStrings[7][common::CivilDate::ISODateLength];
 };
 } // namespace app
@@ -0,0 +1,53 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "duration.h"
+
+#include <wx/string.h>
+
+namespace app::common
+{
+Duration Duration::Parse(const std::string& value)
+{
+    Duration duration;
+    TryParse(value.data(), value.size(), duration);
+    return duration;
+}
+
+Duration Duration::Parse(const wxString& value)
+{
+    Duration duration;
+    TryParse(value.wx_str(), value.length(), duration);
+    return duration;
+}
+
+std::string Duration::ToStdString() const
+{
+    char buffer[MaxFormattedLength];
+    std::size_t length = Format(buffer);
+    return std::string(buffer, length);
+}
+
+wxString Duration::ToString() const
+{
+    char buffer[MaxFormattedLength];
+    std::size_t length = Format(buffer);
+    return wxString::FromAscii(buffer, length);
+}
+} // namespace app::common
@@ -0,0 +1,221 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <string>
+
+class wxString;
+
+namespace app::common
+{
+/*
+ * Length of time in whole seconds, stored and displayed as HH:MM:SS.
+ * Parsing and formatting work on caller supplied buffers so summing and printing durations never allocates.
+ */
+class Duration final
+{
+public:
+    /* INT_MAX seconds needs six hour digits, plus ":MM:SS" and the terminator */
+    static constexpr std::size_t MaxFormattedLength = 16;
+    /* The most hours that still leave room for 59:59 in an int of seconds */
+    static constexpr int MaxHours = (INT_MAX - 3599) / 3600;
+
+    constexpr Duration()
+        : mSeconds(0)
+    {
+    }
+
+    constexpr explicit Duration(int seconds)
+        : mSeconds(seconds)
+    {
+    }
+
+    static constexpr Duration FromHoursMinutesSeconds(int hours, int minutes, int seconds)
+    {
+        return Duration(hours * 3600 + minutes * 60 + seconds);
+    }
+
+    /* Accepts one or more hour digits followed by :MM:SS, which covers every value the task_items table holds */
+    template<typename CharT>
+    static constexpr bool TryParse(const CharT* value, std::size_t length, Duration& duration)
+    {
+        if (length < 7) {
+            return false;
+        }
+
+        std::size_t colon = length - 6;
+        if (value[colon] != ':' || value[colon + 3] != ':') {
+            return false;
+        }
+
+        int hours = 0;
+        for (std::size_t i = 0; i < colon; i++) {
+            if (value[i] < '0' || value[i] > '9') {
+                return false;
+            }
+            hours = hours * 10 + (value[i] - '0');
+            /* checked every digit, so hours never gets near overflowing on the next one */
+            if (hours > MaxHours) {
+                return false;
+            }
+        }
+
+        int minutes = 0;
+        int seconds = 0;
+        if (!ParseTwoDigits(value + colon + 1, minutes) || !ParseTwoDigits(value + colon + 4, seconds)) {
+            return false;
+        }
+
+        if (minutes > 59 || seconds > 59) {
+            return false;
+        }
+
+        duration = FromHoursMinutesSeconds(hours, minutes, seconds);
+        return true;
+    }
+
+    /* Returns a zero duration when the value is malformed */
+    static Duration Parse(const std::string& value);
+    static Duration Parse(const wxString& value);
+
+    /* Writes HH:MM:SS (hours grow past two digits when needed) and returns the length, excluding the terminator */
+    constexpr std::size_t Format(char (&buffer)[MaxFormattedLength]) const
+    {
+        int value = mSeconds < 0 ? 0 : mSeconds;
+        int hours = value / 3600;
+        int minutes = (value % 3600) / 60;
+        int seconds = value % 60;
+
+        char hourDigits[MaxFormattedLength] = {};
+        std::size_t hourLength = 0;
+        do {
+            hourDigits[hourLength++] = static_cast<char>('0' + hours % 10);
+            hours /= 10;
+        } while (hours > 0);
+
+        std::size_t length = 0;
+        if (hourLength < 2) {
+            buffer[length++] = '0';
+        }
+        while (hourLength > 0) {
+            buffer[length++] = hourDigits[--hourLength];
+        }
+
+        buffer[length++] = ':';
+        buffer[length++] = static_cast<char>('0' + minutes / 10);
+        buffer[length++] = static_cast<char>('0' + minutes % 10);
+        buffer[length++] = ':';
+        buffer[length++] = static_cast<char>('0' + seconds / 10);
+        buffer[length++] = static_cast<char>('0' + seconds % 10);
+        buffer[length] = '\0';
+
+        return length;
+    }
+
+    std::string ToStdString() const;
+    wxString ToString() const;
+
+    constexpr int GetTotalSeconds() const
+    {
+        return mSeconds;
+    }
+
+    constexpr int GetHours() const
+    {
+        return mSeconds / 3600;
+    }
+
+    constexpr int GetMinutes() const
+    {
+        return (mSeconds % 3600) / 60;
+    }
+
+    constexpr int GetSeconds() const
+    {
+        return mSeconds % 60;
+    }
+
+    constexpr bool IsZero() const
+    {
+        return mSeconds == 0;
+    }
+
+    constexpr Duration& operator+=(Duration other)
+    {
+        mSeconds += other.mSeconds;
+        return *this;
+    }
+
+    constexpr Duration& operator-=(Duration other)
+    {
+        mSeconds -= other.mSeconds;
+        return *this;
+    }
+
+    friend constexpr Duration operator+(Duration lhs, Duration rhs)
+    {
+        return Duration(lhs.mSeconds + rhs.mSeconds);
+    }
+
+    friend constexpr Duration operator-(Duration lhs, Duration rhs)
+    {
+        return Duration(lhs.mSeconds - rhs.mSeconds);
+    }
+
+    friend constexpr bool operator==(Duration lhs, Duration rhs)
+    {
+        return lhs.mSeconds == rhs.mSeconds;
+    }
+
+    friend constexpr bool operator!=(Duration lhs, Duration rhs)
+    {
+        return lhs.mSeconds != rhs.mSeconds;
+    }
+
+    friend constexpr bool operator<(Duration lhs, Duration rhs)
+    {
+        return lhs.mSeconds < rhs.mSeconds;
+    }
+
+    friend constexpr bool operator>(Duration lhs, Duration rhs)
+    {
+        return lhs.mSeconds > rhs.mSeconds;
+    }
+
+private:
+    template<typename CharT>
+    static constexpr bool ParseTwoDigits(const CharT* value, int& result)
+    {
+        if (value[0] < '0' || value[0] > '9' || value[1] < '0' || value[1] > '9') {
+            return false;
+        }
+
+        result = (value[0] - '0') * 10 + (value[1] - '0');
+        return true;
+    }
+
+    int mSeconds;
+};
+
+static_assert(Duration::FromHoursMinutesSeconds(1, 30, 15).GetTotalSeconds() == 5415);
+static_assert((Duration(90) + Duration(30)).GetMinutes() == 2);
+} // namespace app::common
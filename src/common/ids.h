@@ -30,6 +30,7 @@ enum class MenuIds : int {
     File_NewCategoryId,
     File_View_WeeklyView,
     File_View_MeetingsView,
+    File_View_AggregateView,
     File_StopwatchTaskId,
     Edit_EditEmployerId,
     Edit_EditClientId,
@@ -53,6 +54,7 @@ static const int ID_NEW_CATEGORY = static_cast<int>(ids::MenuIds::File_NewCatego
 static const int ID_STOPWATCH_TASK = static_cast<int>(ids::MenuIds::File_StopwatchTaskId);
 static const int ID_WEEKLY_VIEW = static_cast<int>(ids::MenuIds::File_View_WeeklyView);
 static const int ID_MEETINGS_VIEW = static_cast<int>(ids::MenuIds::File_View_MeetingsView);
+static const int ID_AGGREGATE_VIEW = static_cast<int>(ids::MenuIds::File_View_AggregateView);
 
 static const int ID_EDIT_EMPLOYER = static_cast<int>(MenuIds::Edit_EditEmployerId);
 static const int ID_EDIT_CLIENT = static_cast<int>(MenuIds::Edit_EditClientId);
@@ -0,0 +1,52 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "phasetimer.h"
+
+namespace app::common
+{
+PhaseTimer::PhaseTimer()
+    : mStart(Clock::now())
+    , mLastMark(mStart)
+    , mPhases()
+{
+}
+
+void PhaseTimer::Mark(const std::string& phase)
+{
+    auto now = Clock::now();
+    mPhases.emplace_back(phase, std::chrono::duration_cast<std::chrono::milliseconds>(now - mLastMark));
+    mLastMark = now;
+}
+
+std::chrono::milliseconds PhaseTimer::GetTotal() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(mLastMark - mStart);
+}
+
+std::string PhaseTimer::ToString() const
+{
+    std::string breakdown;
+    for (const auto& [phase, elapsed] : mPhases) {
+        breakdown += phase + " " + std::to_string(elapsed.count()) + " ms, ";
+    }
+    breakdown += "total " + std::to_string(GetTotal().count()) + " ms";
+    return breakdown;
+}
+} // namespace app::common
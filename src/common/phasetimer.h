@@ -0,0 +1,52 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace app::common
+{
+/*
+ * Measures consecutive phases of a longer operation, such as startup, against a monotonic clock.
+ * Each Mark closes the phase running since the previous mark, and ToString gives a one line breakdown for the log.
+ */
+class PhaseTimer final
+{
+public:
+    PhaseTimer();
+    ~PhaseTimer() = default;
+
+    void Mark(const std::string& phase);
+
+    std::chrono::milliseconds GetTotal() const;
+    /* "logging 2 ms, configuration 5 ms, total 7 ms" */
+    std::string ToString() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point mStart;
+    Clock::time_point mLastMark;
+    std::vector<std::pair<std::string, std::chrono::milliseconds>> mPhases;
+};
+} // namespace app::common
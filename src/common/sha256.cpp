@@ -0,0 +1,174 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace app::common
+{
+namespace
+{
+// clang-format off
+constexpr std::array<std::uint32_t, 64> RoundConstants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+// clang-format on
+
+constexpr std::uint32_t RotateRight(std::uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+} // namespace
+
+Sha256::Sha256()
+    : mState({ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 })
+    , mBlock()
+    , mBlockLength(0)
+    , mTotalLength(0)
+{
+}
+
+void Sha256::Update(const void* data, std::size_t length)
+{
+    auto bytes = static_cast<const std::uint8_t*>(data);
+    mTotalLength += length;
+
+    if (mBlockLength > 0) {
+        std::size_t toCopy = std::min(length, mBlock.size() - mBlockLength);
+        std::memcpy(mBlock.data() + mBlockLength, bytes, toCopy);
+        mBlockLength += toCopy;
+        bytes += toCopy;
+        length -= toCopy;
+
+        if (mBlockLength < mBlock.size()) {
+            return;
+        }
+        Transform(mBlock.data());
+        mBlockLength = 0;
+    }
+
+    /* whole blocks are hashed straight from the caller's buffer */
+    while (length >= mBlock.size()) {
+        Transform(bytes);
+        bytes += mBlock.size();
+        length -= mBlock.size();
+    }
+
+    std::memcpy(mBlock.data(), bytes, length);
+    mBlockLength = length;
+}
+
+Sha256::Digest Sha256::Finalize()
+{
+    std::uint64_t bitLength = mTotalLength * 8;
+
+    mBlock[mBlockLength++] = 0x80;
+    if (mBlockLength > 56) {
+        std::memset(mBlock.data() + mBlockLength, 0, mBlock.size() - mBlockLength);
+        Transform(mBlock.data());
+        mBlockLength = 0;
+    }
+    std::memset(mBlock.data() + mBlockLength, 0, 56 - mBlockLength);
+    for (int i = 0; i < 8; i++) {
+        mBlock[63 - i] = static_cast<std::uint8_t>(bitLength >> (i * 8));
+    }
+    Transform(mBlock.data());
+
+    Digest digest;
+    for (std::size_t i = 0; i < mState.size(); i++) {
+        digest[i * 4] = static_cast<std::uint8_t>(mState[i] >> 24);
+        digest[i * 4 + 1] = static_cast<std::uint8_t>(mState[i] >> 16);
+        digest[i * 4 + 2] = static_cast<std::uint8_t>(mState[i] >> 8);
+        digest[i * 4 + 3] = static_cast<std::uint8_t>(mState[i]);
+    }
+    return digest;
+}
+
+std::string Sha256::ToHex(const Digest& digest)
+{
+    static const char HexDigits[] = "0123456789abcdef";
+
+    std::string hex(DigestSize * 2, '0');
+    for (std::size_t i = 0; i < DigestSize; i++) {
+        hex[i * 2] = HexDigits[digest[i] >> 4];
+        hex[i * 2 + 1] = HexDigits[digest[i] & 0x0f];
+    }
+    return hex;
+}
+
+std::string Sha256::HashHex(const void* data, std::size_t length)
+{
+    Sha256 sha256;
+    sha256.Update(data, length);
+    return ToHex(sha256.Finalize());
+}
+
+void Sha256::Transform(const std::uint8_t* block)
+{
+    std::uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (static_cast<std::uint32_t>(block[i * 4]) << 24) | (static_cast<std::uint32_t>(block[i * 4 + 1]) << 16) |
+               (static_cast<std::uint32_t>(block[i * 4 + 2]) << 8) | static_cast<std::uint32_t>(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; i++) {
+        std::uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        std::uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    std::uint32_t a = mState[0], b = mState[1], c = mState[2], d = mState[3];
+    std::uint32_t e = mState[4], f = mState[5], g = mState[6], h = mState[7];
+
+    for (int i = 0; i < 64; i++) {
+        std::uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+        std::uint32_t choose = (e & f) ^ (~e & g);
+        std::uint32_t temp1 = h + s1 + choose + RoundConstants[i] + w[i];
+        std::uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+        std::uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        std::uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    mState[0] += a;
+    mState[1] += b;
+    mState[2] += c;
+    mState[3] += d;
+    mState[4] += e;
+    mState[5] += f;
+    mState[6] += g;
+    mState[7] += h;
+}
+} // namespace app::common
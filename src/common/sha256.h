@@ -0,0 +1,53 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace app::common
+{
+/* Incremental SHA-256 (FIPS 180-4), used to name content addressed backup chunks */
+class Sha256 final
+{
+public:
+    static constexpr std::size_t DigestSize = 32;
+    using Digest = std::array<std::uint8_t, DigestSize>;
+
+    Sha256();
+    ~Sha256() = default;
+
+    void Update(const void* data, std::size_t length);
+    Digest Finalize();
+
+    static std::string ToHex(const Digest& digest);
+    static std::string HashHex(const void* data, std::size_t length);
+
+private:
+    void Transform(const std::uint8_t* block);
+
+    std::array<std::uint32_t, 8> mState;
+    std::array<std::uint8_t, 64> mBlock;
+    std::size_t mBlockLength;
+    std::uint64_t mTotalLength;
+};
+} // namespace app::common
@@ -19,6 +19,8 @@
 
 #include "configuration.h"
 
+#include <exception>
+#include <filesystem>
 #include <fstream>
 
 #include <wx/stdpaths.h>
@@ -36,337 +38,604 @@ const std::string Configuration::Sections::PersistenceSection = "persistence";
 const std::string Configuration::Sections::ExportSection = "export";
 
 Configuration::Configuration()
-    : mSettings()
+    : pSettings(nullptr)
+    , mUpdateMutex()
+    , mWrittenContent()
+    , pSaveTimer(nullptr)
 {
     LoadConfigFile();
 }
 
-// clang-format off
+Configuration::Configuration(Snapshot snapshot)
+    : pSettings(std::move(snapshot))
+    , mUpdateMutex()
+    , mWrittenContent()
+    , pSaveTimer(nullptr)
+{
+}
+
+Configuration::~Configuration()
+{
+    if (pSaveTimer) {
+        pSaveTimer->Stop();
+    }
+}
+
 void Configuration::Save()
+{
+    /* callers save after every change, so bursts (e.g. typing a delimiter) are coalesced into a single write */
+    if (!pSaveTimer) {
+        pSaveTimer = std::make_unique<SaveTimer>(*this);
+    }
+
+    pSaveTimer->StartOnce(SaveDelay);
+}
+
+void Configuration::Flush()
+{
+    if (pSaveTimer) {
+        pSaveTimer->Stop();
+    }
+
+    const std::string configString = Serialize(*GetSnapshot());
+    if (configString == mWrittenContent) {
+        return;
+    }
+
+    if (WriteConfigFile(configString)) {
+        mWrittenContent = configString;
+    }
+}
+
+bool Configuration::Reload(std::string& error)
+{
+    /* the pending write replaces the file with the unsaved changes, which win over the edit */
+    if (pSaveTimer && pSaveTimer->IsRunning()) {
+        return false;
+    }
+
+    /* an editor may still be writing the file, a document that fails to parse is picked up on its next change */
+    Settings settings;
+    try {
+        settings = ParseConfigFile();
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    const std::string configString = Serialize(settings);
+    if (configString == mWrittenContent) {
+        return false;
+    }
+
+    error = Validate(settings);
+    if (!error.empty()) {
+        return false;
+    }
+
+    Publish(settings);
+    mWrittenContent = configString;
+    return true;
+}
+
+Configuration::Snapshot Configuration::GetSnapshot() const
+{
+    return std::atomic_load(&pSettings);
+}
+
+void Configuration::Publish(const Settings& settings)
+{
+    std::lock_guard<std::mutex> lock(mUpdateMutex);
+    std::atomic_store(&pSettings, std::make_shared<const Settings>(settings));
+}
+
+std::string Configuration::Validate(const Settings& settings)
+{
+    if (settings.BackupEnabled && settings.BackupPath.empty()) {
+        return "A backup path must be selected.";
+    }
+
+    if (settings.BackupEnabled && settings.DeleteBackupsAfter <= 0) {
+        return "A positive non-zero value is required if backups are enabled";
+    }
+
+    if (settings.ExportPath.empty()) {
+        return "A export path must be selected";
+    }
+
+    if (settings.Delimiter.empty()) {
+        return "A delimiter is required";
+    }
+
+    return std::string();
+}
+
+void Configuration::Update(const std::function<void(Settings&)>& change)
+{
+    /* readers keep whatever snapshot they loaded, so every change is applied to a copy and swapped in whole */
+    std::lock_guard<std::mutex> lock(mUpdateMutex);
+    auto settings = std::make_shared<Settings>(*std::atomic_load(&pSettings));
+    change(*settings);
+    std::atomic_store(&pSettings, std::shared_ptr<const Settings>(std::move(settings)));
+}
+
+Configuration::SaveTimer::SaveTimer(Configuration& configuration)
+    : wxTimer()
+    , mConfiguration(configuration)
+{
+}
+
+void Configuration::SaveTimer::Notify()
+{
+    mConfiguration.Flush();
+}
+
+// clang-format off
+std::string Configuration::Serialize(const Settings& settings)
 {
     // TODO, refactor this to be more maintainable
     const toml::value data{
         {
             Sections::GeneralSection,
             {
-                { "startOnBoot", mSettings.StartOnBoot },
-                { "showInTray", mSettings.ShowInTray },
-                { "minimizeToTray", mSettings.MinimizeToTray },
-                { "closeToTray", mSettings.CloseToTray },
+                { "startOnBoot", settings.StartOnBoot },
+                { "showInTray", settings.ShowInTray },
+                { "minimizeToTray", settings.MinimizeToTray },
+                { "closeToTray", settings.CloseToTray },
             }
         },
         {
             Sections::DatabaseSection,
             {
-                { "databasePath", mSettings.DatabasePath },
-                { "backupEnabled", mSettings.BackupEnabled },
-                { "backupPath", mSettings.BackupPath },
-                { "deleteBackupsAfter", mSettings.DeleteBackupsAfter }
+                { "databasePath", settings.DatabasePath },
+                { "backupEnabled", settings.BackupEnabled },
+                { "backupPath", settings.BackupPath },
+                { "deleteBackupsAfter", settings.DeleteBackupsAfter },
+                { "backupInterval", settings.BackupInterval },
+                { "keepDailyBackups", settings.KeepDailyBackups },
+                { "keepWeeklyBackups", settings.KeepWeeklyBackups },
+                { "keepMonthlyBackups", settings.KeepMonthlyBackups },
+                { "integrityCheckInterval", settings.IntegrityCheckInterval },
+                { "compressBackups", settings.CompressBackups },
+                { "incrementalBackups", settings.IncrementalBackups }
             }
         },
         {
             Sections::StopwatchSection,
             {
-                { "minimizeStopwatchWindow", mSettings.MinimizeStopwatchWindow },
-                { "hideWindowTimer", mSettings.HideWindowTimerInterval },
-                { "notificationTimer", mSettings.NotificationTimerInterval },
-                { "pausedTaskReminder", mSettings.PausedTaskReminderInterval },
-                { "startStopwatchOnLaunch", mSettings.StartStopwatchOnLaunch },
-                { "startStopwatchOnResume", mSettings.StartStopwatchOnResume },
+                { "minimizeStopwatchWindow", settings.MinimizeStopwatchWindow },
+                { "hideWindowTimer", settings.HideWindowTimerInterval },
+                { "notificationTimer", settings.NotificationTimerInterval },
+                { "pausedTaskReminder", settings.PausedTaskReminderInterval },
+                { "startStopwatchOnLaunch", settings.StartStopwatchOnLaunch },
+                { "startStopwatchOnResume", settings.StartStopwatchOnResume },
             }
         },
         {
             Sections::TaskItemSection,
             {
-                { "timeRounding", mSettings.TimeRounding },
-                { "timeToRoundTo", mSettings.TimeToRoundTo }
+                { "timeRounding", settings.TimeRounding },
+                { "timeToRoundTo", settings.TimeToRoundTo }
             }
         },
         {
             Sections::PersistenceSection,
             {
-                { "dimensions", mSettings.Dimension }
+                { "dimensions", settings.Dimension }
             }
         },
         {
             Sections::ExportSection,
             {
-                { "delimiter", mSettings.Delimiter },
-                { "exportPath", mSettings.ExportPath }
+                { "delimiter", settings.Delimiter },
+                { "exportPath", settings.ExportPath },
+                { "compressionLevel", settings.CompressionLevel },
+                { "columns", settings.ExportColumns }
             }
         }
     };
 
-    const std::string configString = toml::format(data);
+    return toml::format(data);
+}
+// clang-format on
 
+bool Configuration::WriteConfigFile(const std::string& content)
+{
+    /* a crash mid-write must never leave a truncated file behind, toml::parse would throw on the next start */
     const std::string configFilePath = common::GetConfigFilePath().ToStdString();
-    std::ofstream configFile;
-    configFile.open(configFilePath, std::ios_base::out);
-    if (!configFile)
+    const std::string temporaryFilePath = configFilePath + ".tmp";
+
     {
-         // log error
-        return;
+        std::ofstream configFile(temporaryFilePath, std::ios_base::out | std::ios_base::trunc);
+        if (!configFile) {
+            return false;
+        }
+
+        configFile << content;
+        configFile.flush();
+        if (!configFile) {
+            configFile.close();
+            std::error_code ignored;
+            std::filesystem::remove(temporaryFilePath, ignored);
+            return false;
+        }
     }
 
-    configFile << configString;
+    std::error_code error;
+    std::filesystem::rename(temporaryFilePath, configFilePath, error);
+    if (error) {
+        std::error_code ignored;
+        std::filesystem::remove(temporaryFilePath, ignored);
+        return false;
+    }
 
-    configFile.close();
+    return true;
 }
-// clang-format on
 
 bool Configuration::IsStartOnBoot() const
 {
-    return mSettings.StartOnBoot;
+    return GetSnapshot()->StartOnBoot;
 }
 
 bool Configuration::IsShowInTray() const
 {
-    return mSettings.ShowInTray;
+    return GetSnapshot()->ShowInTray;
 }
 
 bool Configuration::IsMinimizeToTray() const
 {
-    return mSettings.MinimizeToTray;
+    return GetSnapshot()->MinimizeToTray;
 }
 
 bool Configuration::IsCloseToTray() const
 {
-    return mSettings.CloseToTray;
+    return GetSnapshot()->CloseToTray;
 }
 
 std::string Configuration::GetDatabasePath() const
 {
-    return mSettings.DatabasePath;
+    return GetSnapshot()->DatabasePath;
 }
 
 bool Configuration::IsBackupEnabled() const
 {
-    return mSettings.BackupEnabled;
+    return GetSnapshot()->BackupEnabled;
 }
 
 std::string Configuration::GetBackupPath() const
 {
-    return mSettings.BackupPath;
+    return GetSnapshot()->BackupPath;
 }
 
 int Configuration::GetDeleteBackupsAfter() const
 {
-    return mSettings.DeleteBackupsAfter;
+    return GetSnapshot()->DeleteBackupsAfter;
+}
+
+int Configuration::GetBackupInterval() const
+{
+    return GetSnapshot()->BackupInterval;
+}
+
+int Configuration::GetKeepDailyBackups() const
+{
+    return GetSnapshot()->KeepDailyBackups;
+}
+
+int Configuration::GetKeepWeeklyBackups() const
+{
+    return GetSnapshot()->KeepWeeklyBackups;
+}
+
+int Configuration::GetKeepMonthlyBackups() const
+{
+    return GetSnapshot()->KeepMonthlyBackups;
+}
+
+int Configuration::GetIntegrityCheckInterval() const
+{
+    return GetSnapshot()->IntegrityCheckInterval;
+}
+
+bool Configuration::IsCompressBackups() const
+{
+    return GetSnapshot()->CompressBackups;
+}
+
+bool Configuration::IsIncrementalBackups() const
+{
+    return GetSnapshot()->IncrementalBackups;
 }
 
 bool Configuration::IsMinimizeStopwatchWindow() const
 {
-    return mSettings.MinimizeStopwatchWindow;
+    return GetSnapshot()->MinimizeStopwatchWindow;
 }
 
 int Configuration::GetHideWindowTimerInterval() const
 {
-    return mSettings.HideWindowTimerInterval;
+    return GetSnapshot()->HideWindowTimerInterval;
 }
 
 int Configuration::GetNotificationTimerInterval() const
 {
-    return mSettings.NotificationTimerInterval;
+    return GetSnapshot()->NotificationTimerInterval;
 }
 
 int Configuration::GetPausedTaskReminderInterval() const
 {
-    return mSettings.PausedTaskReminderInterval;
+    return GetSnapshot()->PausedTaskReminderInterval;
 }
 
 bool Configuration::IsStartStopwatchOnLaunch() const
 {
-    return mSettings.StartStopwatchOnLaunch;
+    return GetSnapshot()->StartStopwatchOnLaunch;
 }
 
 bool Configuration::IsStartStopwatchOnResume() const
 {
-    return mSettings.StartStopwatchOnResume;
+    return GetSnapshot()->StartStopwatchOnResume;
 }
 
 bool Configuration::IsTimeRoundingEnabled() const
 {
-    return mSettings.TimeRounding;
+    return GetSnapshot()->TimeRounding;
 }
 
 int Configuration::GetTimeToRoundTo() const
 {
-    return mSettings.TimeToRoundTo;
+    return GetSnapshot()->TimeToRoundTo;
 }
 
 std::string Configuration::GetFrameSize() const
 {
-    return mSettings.Dimension;
+    return GetSnapshot()->Dimension;
 }
 
 std::string Configuration::GetDelimiter() const
 {
-    return mSettings.Delimiter;
+    return GetSnapshot()->Delimiter;
 }
 
 std::string Configuration::GetExportPath() const
 {
-    return mSettings.ExportPath;
+    return GetSnapshot()->ExportPath;
+}
+
+int Configuration::GetCompressionLevel() const
+{
+    return GetSnapshot()->CompressionLevel;
+}
+
+std::vector<std::string> Configuration::GetExportColumns() const
+{
+    return GetSnapshot()->ExportColumns;
 }
 
 void Configuration::SetStartOnBoot(bool value)
 {
-    mSettings.StartOnBoot = value;
+    Update([&](Settings& settings) { settings.StartOnBoot = value; });
 }
 
 void Configuration::SetShowInTray(bool value)
 {
-    mSettings.ShowInTray = value;
+    Update([&](Settings& settings) { settings.ShowInTray = value; });
 }
 
 void Configuration::SetMinimizeToTray(bool value)
 {
-    mSettings.MinimizeToTray = value;
+    Update([&](Settings& settings) { settings.MinimizeToTray = value; });
 }
 
 void Configuration::SetCloseToTray(bool value)
 {
-    mSettings.CloseToTray = value;
+    Update([&](Settings& settings) { settings.CloseToTray = value; });
 }
 
 void Configuration::SetDatabasePath(const std::string& value)
 {
-    mSettings.DatabasePath = value;
+    Update([&](Settings& settings) { settings.DatabasePath = value; });
 }
 
 void Configuration::SetBackupEnabled(bool value)
 {
-    mSettings.BackupEnabled = value;
+    Update([&](Settings& settings) { settings.BackupEnabled = value; });
 }
 
 void Configuration::SetBackupPath(const std::string& value)
 {
-    mSettings.BackupPath = value;
+    Update([&](Settings& settings) { settings.BackupPath = value; });
 }
 
 void Configuration::SetDeleteBackupsAfter(int value)
 {
-    mSettings.DeleteBackupsAfter = value;
+    Update([&](Settings& settings) { settings.DeleteBackupsAfter = value; });
+}
+
+void Configuration::SetBackupInterval(int value)
+{
+    Update([&](Settings& settings) { settings.BackupInterval = value; });
+}
+
+void Configuration::SetKeepDailyBackups(int value)
+{
+    Update([&](Settings& settings) { settings.KeepDailyBackups = value; });
+}
+
+void Configuration::SetKeepWeeklyBackups(int value)
+{
+    Update([&](Settings& settings) { settings.KeepWeeklyBackups = value; });
+}
+
+void Configuration::SetKeepMonthlyBackups(int value)
+{
+    Update([&](Settings& settings) { settings.KeepMonthlyBackups = value; });
+}
+
+void Configuration::SetIntegrityCheckInterval(int value)
+{
+    Update([&](Settings& settings) { settings.IntegrityCheckInterval = value; });
+}
+
+void Configuration::SetCompressBackups(bool value)
+{
+    Update([&](Settings& settings) { settings.CompressBackups = value; });
+}
+
+void Configuration::SetIncrementalBackups(bool value)
+{
+    Update([&](Settings& settings) { settings.IncrementalBackups = value; });
 }
 
 void Configuration::SetMinimizeStopwatchWindow(bool value)
 {
-    mSettings.MinimizeStopwatchWindow = value;
+    Update([&](Settings& settings) { settings.MinimizeStopwatchWindow = value; });
 }
 
 void Configuration::SetHideWindowTimerInterval(int value)
 {
-    mSettings.HideWindowTimerInterval = value;
+    Update([&](Settings& settings) { settings.HideWindowTimerInterval = value; });
 }
 
 void Configuration::SetNotificationTimerInterval(int value)
 {
-    mSettings.NotificationTimerInterval = value;
+    Update([&](Settings& settings) { settings.NotificationTimerInterval = value; });
 }
 
 void Configuration::SetPausedTaskReminderInterval(int value)
 {
-    mSettings.PausedTaskReminderInterval = value;
+    Update([&](Settings& settings) { settings.PausedTaskReminderInterval = value; });
 }
 
 void Configuration::SetStartStopwatchOnLaunch(bool value)
 {
-    mSettings.StartStopwatchOnLaunch = value;
+    Update([&](Settings& settings) { settings.StartStopwatchOnLaunch = value; });
 }
 
 void Configuration::SetStartStopwatchOnResume(bool value)
 {
-    mSettings.StartStopwatchOnResume;
+    Update([&](Settings& settings) { settings.StartStopwatchOnResume = value; });
 }
 
 void Configuration::SetTimeRounding(bool value)
 {
-    mSettings.TimeRounding = value;
+    Update([&](Settings& settings) { settings.TimeRounding = value; });
 }
 
 void Configuration::SetTimeToRoundTo(int value)
 {
-    mSettings.TimeToRoundTo = value;
+    Update([&](Settings& settings) { settings.TimeToRoundTo = value; });
 }
 
 void Configuration::SetFrameSize(const std::string& value)
 {
-    mSettings.Dimension = value;
+    Update([&](Settings& settings) { settings.Dimension = value; });
 }
 
 void Configuration::SetDelimiter(const std::string& value)
 {
-    mSettings.Delimiter = value;
+    Update([&](Settings& settings) { settings.Delimiter = value; });
 }
 
 void Configuration::SetExportPath(const std::string& value)
 {
-    mSettings.ExportPath = value;
+    Update([&](Settings& settings) { settings.ExportPath = value; });
+}
+
+void Configuration::SetCompressionLevel(int value)
+{
+    Update([&](Settings& settings) { settings.CompressionLevel = value; });
+}
+
+void Configuration::SetExportColumns(const std::vector<std::string>& value)
+{
+    Update([&](Settings& settings) { settings.ExportColumns = value; });
 }
 
 void Configuration::LoadConfigFile()
+{
+    Settings settings = ParseConfigFile();
+
+    mWrittenContent = Serialize(settings);
+    Publish(settings);
+}
+
+Configuration::Settings Configuration::ParseConfigFile()
 {
     auto data = toml::parse(common::GetConfigFilePath());
 
-    GetGeneralConfig(data);
-    GetDatabaseConfig(data);
-    GetStopwatchConfig(data);
-    GetTaskItemConfig(data);
-    GetPersistenceConfig(data);
-    GetExportConfig(data);
+    Settings settings;
+    GetGeneralConfig(data, settings);
+    GetDatabaseConfig(data, settings);
+    GetStopwatchConfig(data, settings);
+    GetTaskItemConfig(data, settings);
+    GetPersistenceConfig(data, settings);
+    GetExportConfig(data, settings);
+    return settings;
 }
 
-void Configuration::GetGeneralConfig(const toml::value& config)
+void Configuration::GetGeneralConfig(const toml::value& config, Settings& settings)
 {
     const auto& generalSection = toml::find(config, Sections::GeneralSection);
 
-    mSettings.StartOnBoot = toml::find<bool>(generalSection, "startOnBoot");
-    mSettings.ShowInTray = toml::find<bool>(generalSection, "showInTray");
-    mSettings.MinimizeToTray = toml::find<bool>(generalSection, "minimizeToTray");
-    mSettings.CloseToTray = toml::find<bool>(generalSection, "closeToTray");
+    settings.StartOnBoot = toml::find<bool>(generalSection, "startOnBoot");
+    settings.ShowInTray = toml::find<bool>(generalSection, "showInTray");
+    settings.MinimizeToTray = toml::find<bool>(generalSection, "minimizeToTray");
+    settings.CloseToTray = toml::find<bool>(generalSection, "closeToTray");
 }
 
-void Configuration::GetDatabaseConfig(const toml::value& config)
+void Configuration::GetDatabaseConfig(const toml::value& config, Settings& settings)
 {
     const auto& databaseSection = toml::find(config, Sections::DatabaseSection);
 
-    mSettings.DatabasePath = toml::find<std::string>(databaseSection, "databasePath");
-    mSettings.BackupEnabled = toml::find<bool>(databaseSection, "backupEnabled");
-    mSettings.BackupPath = toml::find<std::string>(databaseSection, "backupPath");
-    mSettings.DeleteBackupsAfter = toml::find<int>(databaseSection, "deleteBackupsAfter");
+    settings.DatabasePath = toml::find<std::string>(databaseSection, "databasePath");
+    settings.BackupEnabled = toml::find<bool>(databaseSection, "backupEnabled");
+    settings.BackupPath = toml::find<std::string>(databaseSection, "backupPath");
+    settings.DeleteBackupsAfter = toml::find<int>(databaseSection, "deleteBackupsAfter");
+    settings.BackupInterval = toml::find_or<int>(databaseSection, "backupInterval", DefaultBackupInterval);
+    settings.KeepDailyBackups = toml::find_or<int>(databaseSection, "keepDailyBackups", 0);
+    settings.KeepWeeklyBackups = toml::find_or<int>(databaseSection, "keepWeeklyBackups", 0);
+    settings.KeepMonthlyBackups = toml::find_or<int>(databaseSection, "keepMonthlyBackups", 0);
+    settings.IntegrityCheckInterval = toml::find_or<int>(databaseSection, "integrityCheckInterval", 0);
+    settings.CompressBackups = toml::find_or<bool>(databaseSection, "compressBackups", false);
+    settings.IncrementalBackups = toml::find_or<bool>(databaseSection, "incrementalBackups", false);
 }
 
-void Configuration::GetStopwatchConfig(const toml::value& config)
+void Configuration::GetStopwatchConfig(const toml::value& config, Settings& settings)
 {
     const auto& stopwatchSection = toml::find(config, Sections::StopwatchSection);
 
-    mSettings.MinimizeStopwatchWindow = toml::find<bool>(stopwatchSection, "minimizeStopwatchWindow");
-    mSettings.HideWindowTimerInterval = toml::find<int>(stopwatchSection, "hideWindowTimer");
-    mSettings.NotificationTimerInterval = toml::find<int>(stopwatchSection, "notificationTimer");
-    mSettings.PausedTaskReminderInterval = toml::find<int>(stopwatchSection, "pausedTaskReminder");
-    mSettings.StartStopwatchOnLaunch = toml::find<bool>(stopwatchSection, "startStopwatchOnLaunch");
-    mSettings.StartStopwatchOnResume = toml::find<bool>(stopwatchSection, "startStopwatchOnResume");
+    settings.MinimizeStopwatchWindow = toml::find<bool>(stopwatchSection, "minimizeStopwatchWindow");
+    settings.HideWindowTimerInterval = toml::find<int>(stopwatchSection, "hideWindowTimer");
+    settings.NotificationTimerInterval = toml::find<int>(stopwatchSection, "notificationTimer");
+    settings.PausedTaskReminderInterval = toml::find<int>(stopwatchSection, "pausedTaskReminder");
+    settings.StartStopwatchOnLaunch = toml::find<bool>(stopwatchSection, "startStopwatchOnLaunch");
+    settings.StartStopwatchOnResume = toml::find<bool>(stopwatchSection, "startStopwatchOnResume");
 }
 
-void Configuration::GetTaskItemConfig(const toml::value& config)
+void Configuration::GetTaskItemConfig(const toml::value& config, Settings& settings)
 {
     const auto& taskItemSection = toml::find(config, Sections::TaskItemSection);
 
-    mSettings.TimeRounding = toml::find<bool>(taskItemSection, "timeRounding");
-    mSettings.TimeToRoundTo = toml::find<int>(taskItemSection, "timeToRoundTo");
+    settings.TimeRounding = toml::find<bool>(taskItemSection, "timeRounding");
+    settings.TimeToRoundTo = toml::find<int>(taskItemSection, "timeToRoundTo");
 }
 
-void Configuration::GetPersistenceConfig(const toml::value& config)
+void Configuration::GetPersistenceConfig(const toml::value& config, Settings& settings)
 {
     const auto& persistenceSection = toml::find(config, Sections::PersistenceSection);
 
-    mSettings.Dimension = toml::find<std::string>(persistenceSection, "dimensions");
+    settings.Dimension = toml::find<std::string>(persistenceSection, "dimensions");
 }
-void Configuration::GetExportConfig(const toml::value& config)
+void Configuration::GetExportConfig(const toml::value& config, Settings& settings)
 {
     const auto exportSection = toml::find(config, Sections::ExportSection);
 
-    mSettings.Delimiter = toml::find<std::string>(exportSection, "delimiter");
-    mSettings.ExportPath = toml::find<std::string>(exportSection, "exportPath");
+    settings.Delimiter = toml::find<std::string>(exportSection, "delimiter");
+    settings.ExportPath = toml::find<std::string>(exportSection, "exportPath");
+    /* configuration files written before compressed exports existed do not have this key */
+    settings.CompressionLevel = toml::find_or<int>(exportSection, "compressionLevel", DefaultCompressionLevel);
+    /* an empty list exports the default columns */
+    settings.ExportColumns =
+        toml::find_or<std::vector<std::string>>(exportSection, "columns", std::vector<std::string>());
 }
 } // namespace app::cfg
@@ -19,21 +19,85 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <toml.hpp>
 
 #include <wx/gdicmn.h>
+#include <wx/timer.h>
 
 namespace app::cfg
 {
 class Configuration
 {
 public:
+    struct Settings {
+        bool StartOnBoot;
+        bool ShowInTray;
+        bool MinimizeToTray;
+        bool CloseToTray;
+
+        std::string DatabasePath;
+        bool BackupEnabled;
+        std::string BackupPath;
+        int DeleteBackupsAfter;
+        int BackupInterval;
+        int KeepDailyBackups;
+        int KeepWeeklyBackups;
+        int KeepMonthlyBackups;
+        int IntegrityCheckInterval;
+        bool CompressBackups;
+        bool IncrementalBackups;
+
+        bool MinimizeStopwatchWindow;
+        int HideWindowTimerInterval;
+        int NotificationTimerInterval;
+        int PausedTaskReminderInterval;
+        bool StartStopwatchOnLaunch;
+        bool StartStopwatchOnResume;
+
+        bool TimeRounding;
+        int TimeToRoundTo;
+
+        std::string Dimension;
+
+        std::string Delimiter;
+        std::string ExportPath;
+        int CompressionLevel;
+        std::vector<std::string> ExportColumns;
+
+        Settings() = default;
+        ~Settings() = default;
+    };
+
+    /* an immutable view of every setting, safe to hold on any thread while the configuration changes */
+    using Snapshot = std::shared_ptr<const Settings>;
+
     Configuration();
-    ~Configuration() = default;
+    /* a detached copy for editing, e.g. by the preferences dialog, that never touches the file */
+    explicit Configuration(Snapshot snapshot);
+    ~Configuration();
 
+    /* schedules a write, repeated calls within SaveDelay result in one write */
     void Save();
+    /* writes pending changes immediately, only touches the file when a setting changed */
+    void Flush();
+    /*
+     * Re-reads the file after an external edit, returns true when a new snapshot was published.
+     * Nothing is read while a save is pending, and settings that fail Validate are rejected with the reason in error.
+     */
+    bool Reload(std::string& error);
+
+    Snapshot GetSnapshot() const;
+    /* swaps in all settings at once */
+    void Publish(const Settings& settings);
+
+    /* the rules every published set of settings meets, returns what is wrong or an empty string */
+    static std::string Validate(const Settings& settings);
 
     /* Getters */
     bool IsStartOnBoot() const;
@@ -45,6 +109,13 @@ class Configuration
     bool IsBackupEnabled() const;
     std::string GetBackupPath() const;
     int GetDeleteBackupsAfter() const;
+    int GetBackupInterval() const;
+    int GetKeepDailyBackups() const;
+    int GetKeepWeeklyBackups() const;
+    int GetKeepMonthlyBackups() const;
+    int GetIntegrityCheckInterval() const;
+    bool IsCompressBackups() const;
+    bool IsIncrementalBackups() const;
 
     bool IsMinimizeStopwatchWindow() const;
     int GetHideWindowTimerInterval() const;
@@ -60,6 +131,8 @@ class Configuration
 
     std::string GetDelimiter() const;
     std::string GetExportPath() const;
+    int GetCompressionLevel() const;
+    std::vector<std::string> GetExportColumns() const;
 
     /* Setters */
     void SetStartOnBoot(bool value);
@@ -71,6 +144,13 @@ class Configuration
     void SetBackupEnabled(bool value);
     void SetBackupPath(const std::string& value);
     void SetDeleteBackupsAfter(int value);
+    void SetBackupInterval(int value);
+    void SetKeepDailyBackups(int value);
+    void SetKeepWeeklyBackups(int value);
+    void SetKeepMonthlyBackups(int value);
+    void SetIntegrityCheckInterval(int value);
+    void SetCompressBackups(bool value);
+    void SetIncrementalBackups(bool value);
 
     void SetMinimizeStopwatchWindow(bool value);
     void SetHideWindowTimerInterval(int value);
@@ -86,16 +166,42 @@ class Configuration
 
     void SetDelimiter(const std::string& value);
     void SetExportPath(const std::string& value);
+    void SetCompressionLevel(int value);
+    void SetExportColumns(const std::vector<std::string>& value);
 
 private:
-    void LoadConfigFile();
+    class SaveTimer final : public wxTimer
+    {
+    public:
+        SaveTimer() = delete;
+        explicit SaveTimer(Configuration& configuration);
+        virtual ~SaveTimer() = default;
 
-    void GetGeneralConfig(const toml::value& config);
-    void GetDatabaseConfig(const toml::value& config);
-    void GetStopwatchConfig(const toml::value& config);
-    void GetTaskItemConfig(const toml::value& config);
-    void GetPersistenceConfig(const toml::value& config);
-    void GetExportConfig(const toml::value& config);
+        void Notify() override;
+
+    private:
+        Configuration& mConfiguration;
+    };
+
+    void LoadConfigFile();
+    static Settings ParseConfigFile();
+    static std::string Serialize(const Settings& settings);
+    void Update(const std::function<void(Settings&)>& change);
+    bool WriteConfigFile(const std::string& content);
+
+    static void GetGeneralConfig(const toml::value& config, Settings& settings);
+    static void GetDatabaseConfig(const toml::value& config, Settings& settings);
+    static void GetStopwatchConfig(const toml::value& config, Settings& settings);
+    static void GetTaskItemConfig(const toml::value& config, Settings& settings);
+    static void GetPersistenceConfig(const toml::value& config, Settings& settings);
+    static void GetExportConfig(const toml::value& config, Settings& settings);
+
+    /* minutes between scheduled backups */
+    static const int DefaultBackupInterval = 60;
+    /* zlib's own default, a good balance between size and speed */
+    static const int DefaultCompressionLevel = 6;
+    /* milliseconds to wait for further changes before writing the file */
+    static const int SaveDelay = 500;
 
     struct Sections {
         static const std::string GeneralSection;
@@ -106,36 +212,12 @@ class Configuration
         static const std::string ExportSection;
     };
 
-    struct Settings {
-        bool StartOnBoot;
-        bool ShowInTray;
-        bool MinimizeToTray;
-        bool CloseToTray;
-
-        std::string DatabasePath;
-        bool BackupEnabled;
-        std::string BackupPath;
-        int DeleteBackupsAfter;
-
-        bool MinimizeStopwatchWindow;
-        int HideWindowTimerInterval;
-        int NotificationTimerInterval;
-        int PausedTaskReminderInterval;
-        bool StartStopwatchOnLaunch;
-        bool StartStopwatchOnResume;
-
-        bool TimeRounding;
-        int TimeToRoundTo;
-
-        std::string Dimension;
-
-        std::string Delimiter;
-        std::string ExportPath;
-
-        Settings() = default;
-        ~Settings() = default;
-    };
-
-    Settings mSettings;
+    /* published with std::atomic_load/atomic_store, the pointee is never modified once shared */
+    Snapshot pSettings;
+    /* serializes writers, readers never take it */
+    std::mutex mUpdateMutex;
+    /* what the file on disk currently holds, used to skip writes when nothing changed */
+    std::string mWrittenContent;
+    std::unique_ptr<SaveTimer> pSaveTimer;
 };
 } // namespace app::cfg
@@ -0,0 +1,147 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "aggregatedata.h"
+
+namespace app::data
+{
+AggregateData::AggregateData()
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+}
+
+AggregateData::~AggregateData()
+{
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+}
+
+std::vector<DayTotal> AggregateData::GetDayTotals(common::CivilDate fromDate, common::CivilDate toDate)
+{
+    std::vector<DayTotal> dayTotals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << AggregateData::getDayTotals << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](std::string taskDate, int seconds) { dayTotals.push_back(DayTotal{ common::CivilDate::Parse(taskDate), seconds }); };
+
+    return dayTotals;
+}
+
+std::vector<WeekTotal> AggregateData::GetWeekTotals(common::CivilDate fromDate, common::CivilDate toDate)
+{
+    std::vector<WeekTotal> weekTotals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << AggregateData::getWeekTotals << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](std::string weekStart, int seconds) {
+            weekTotals.push_back(WeekTotal{ common::CivilDate::Parse(weekStart), seconds });
+        };
+
+    return weekTotals;
+}
+
+std::vector<ProjectTotal> AggregateData::GetProjectTotals(common::CivilDate fromDate, common::CivilDate toDate)
+{
+    std::vector<ProjectTotal> projectTotals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << AggregateData::getProjectTotals << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](int projectId, std::string displayName, int seconds) {
+            projectTotals.push_back(ProjectTotal{ projectId, wxString(displayName), seconds });
+        };
+
+    return projectTotals;
+}
+
+std::vector<CategoryTotal> AggregateData::GetCategoryTotals(common::CivilDate fromDate, common::CivilDate toDate)
+{
+    std::vector<CategoryTotal> categoryTotals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << AggregateData::getCategoryTotals << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](int categoryId, std::string name, unsigned int color, int seconds) {
+            categoryTotals.push_back(CategoryTotal{ categoryId, wxString(name), wxColor(color), seconds });
+        };
+
+    return categoryTotals;
+}
+
+/*
+ * task_items.duration is stored as HH:MM:SS so it is converted to seconds before summing.
+ * Hours can run past two digits, so minutes and seconds are taken from the end of the string.
+ */
+static const std::string DurationInSeconds =
+    "(CAST(substr(task_items.duration, 1, length(task_items.duration) - 6) AS INTEGER) * 3600 "
+    "+ CAST(substr(task_items.duration, -5, 2) AS INTEGER) * 60 "
+    "+ CAST(substr(task_items.duration, -2) AS INTEGER))";
+
+const std::string AggregateData::getDayTotals = "SELECT tasks.task_date "
+                                                ", SUM(" + DurationInSeconds + ") "
+                                                "FROM task_items "
+                                                "INNER JOIN tasks "
+                                                "ON task_items.task_id = tasks.task_id "
+                                                "WHERE tasks.task_date >= ? "
+                                                "AND tasks.task_date <= ? "
+                                                "AND task_items.is_active = 1 "
+                                                "GROUP BY tasks.task_date "
+                                                "ORDER BY tasks.task_date";
+
+/* strftime('%w') counts from Sunday, stepping back (weekday + 6) % 7 days lands on the Monday of the week */
+static const std::string WeekStart = "date(tasks.task_date, "
+                                     "'-' || ((CAST(strftime('%w', tasks.task_date) AS INTEGER) + 6) % 7) || ' days')";
+
+const std::string AggregateData::getWeekTotals = "SELECT " + WeekStart + " AS week_start "
+                                                 ", SUM(" + DurationInSeconds + ") "
+                                                 "FROM task_items "
+                                                 "INNER JOIN tasks "
+                                                 "ON task_items.task_id = tasks.task_id "
+                                                 "WHERE tasks.task_date >= ? "
+                                                 "AND tasks.task_date <= ? "
+                                                 "AND task_items.is_active = 1 "
+                                                 "GROUP BY week_start "
+                                                 "ORDER BY week_start";
+
+const std::string AggregateData::getProjectTotals = "SELECT projects.project_id "
+                                                    ", projects.display_name "
+                                                    ", SUM(" + DurationInSeconds + ") AS total "
+                                                    "FROM task_items "
+                                                    "INNER JOIN tasks "
+                                                    "ON task_items.task_id = tasks.task_id "
+                                                    "INNER JOIN projects "
+                                                    "ON task_items.project_id = projects.project_id "
+                                                    "WHERE tasks.task_date >= ? "
+                                                    "AND tasks.task_date <= ? "
+                                                    "AND task_items.is_active = 1 "
+                                                    "GROUP BY projects.project_id "
+                                                    "ORDER BY total DESC";
+
+const std::string AggregateData::getCategoryTotals = "SELECT categories.category_id "
+                                                     ", categories.name "
+                                                     ", categories.color "
+                                                     ", SUM(" + DurationInSeconds + ") AS total "
+                                                     "FROM task_items "
+                                                     "INNER JOIN tasks "
+                                                     "ON task_items.task_id = tasks.task_id "
+                                                     "INNER JOIN categories "
+                                                     "ON task_items.category_id = categories.category_id "
+                                                     "WHERE tasks.task_date >= ? "
+                                                     "AND tasks.task_date <= ? "
+                                                     "AND task_items.is_active = 1 "
+                                                     "GROUP BY categories.category_id "
+                                                     "ORDER BY total DESC";
+} // namespace app::data
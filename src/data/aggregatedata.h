@@ -0,0 +1,80 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wx/colour.h>
+#include <wx/string.h>
+
+#include "../common/civildate.h"
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::data
+{
+struct DayTotal {
+    common::CivilDate Date;
+    int Seconds;
+};
+
+/* Weeks start on Monday, matching the weekly view */
+struct WeekTotal {
+    common::CivilDate WeekStart;
+    int Seconds;
+};
+
+struct ProjectTotal {
+    int ProjectId;
+    wxString DisplayName;
+    int Seconds;
+};
+
+struct CategoryTotal {
+    int CategoryId;
+    wxString Name;
+    wxColor Color;
+    int Seconds;
+};
+
+/* Totals for a date range rolled up by SQLite rather than by loading every task item */
+class AggregateData final
+{
+public:
+    AggregateData();
+    ~AggregateData();
+
+    std::vector<DayTotal> GetDayTotals(common::CivilDate fromDate, common::CivilDate toDate);
+    /* Only the days inside the range count, so the weeks at either end of a month can be partial */
+    std::vector<WeekTotal> GetWeekTotals(common::CivilDate fromDate, common::CivilDate toDate);
+    std::vector<ProjectTotal> GetProjectTotals(common::CivilDate fromDate, common::CivilDate toDate);
+    std::vector<CategoryTotal> GetCategoryTotals(common::CivilDate fromDate, common::CivilDate toDate);
+
+private:
+    std::shared_ptr<db::SqliteConnection> pConnection;
+
+    static const std::string getDayTotals;
+    static const std::string getWeekTotals;
+    static const std::string getProjectTotals;
+    static const std::string getCategoryTotals;
+};
+} // namespace app::data
@@ -0,0 +1,59 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "exportwatermarkdata.h"
+
+#include "../common/util.h"
+
+namespace app::data
+{
+ExportWatermarkData::ExportWatermarkData()
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+}
+
+ExportWatermarkData::~ExportWatermarkData()
+{
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+}
+
+std::int64_t ExportWatermarkData::Get(const std::string& exportName)
+{
+    std::int64_t watermark = 0;
+
+    *pConnection->DatabaseExecutableHandle() << ExportWatermarkData::getWatermark << exportName >>
+        [&](std::int64_t value) { watermark = value; };
+
+    return watermark;
+}
+
+void ExportWatermarkData::Set(const std::string& exportName, std::int64_t watermark)
+{
+    *pConnection->DatabaseExecutableHandle() << ExportWatermarkData::setWatermark << exportName << watermark
+                                             << util::UnixTimestamp();
+}
+
+const std::string ExportWatermarkData::getWatermark = "SELECT watermark "
+                                                      "FROM export_watermarks "
+                                                      "WHERE name = ?";
+
+const std::string ExportWatermarkData::setWatermark = "INSERT OR REPLACE INTO export_watermarks "
+                                                      "(name, watermark, date_modified) "
+                                                      "VALUES (?, ?, ?)";
+} // namespace app::data
@@ -0,0 +1,50 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::data
+{
+/*
+ * Remembers, per export name, the task_items.date_modified value a delta export last covered.
+ * A watermark is a single row so recording a new one is one atomic statement.
+ */
+class ExportWatermarkData final
+{
+public:
+    ExportWatermarkData();
+    ~ExportWatermarkData();
+
+    /* Returns 0 when the export has never run, which makes the first delta a full one */
+    std::int64_t Get(const std::string& exportName);
+    void Set(const std::string& exportName, std::int64_t watermark);
+
+private:
+    std::shared_ptr<db::SqliteConnection> pConnection;
+
+    static const std::string getWatermark;
+    static const std::string setWatermark;
+};
+} // namespace app::data
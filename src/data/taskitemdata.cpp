@@ -63,6 +63,10 @@ int64_t TaskItemData::Create(std::unique_ptr<model::TaskItemModel> taskItem)
         ps << nullptr;
     }
 
+    /* stamp both dates from the same clock Update and Delete use, the column defaults are in local time */
+    auto timestamp = util::UnixTimestamp();
+    ps << timestamp << timestamp;
+
     ps.execute();
 
     return pConnection->DatabaseExecutableHandle()->last_insert_rowid();
@@ -122,16 +126,12 @@ std::unique_ptr<model::TaskItemModel> TaskItemData::GetById(const int taskItemId
             std::unique_ptr<bool> meetingsIsActive,
             std::unique_ptr<int> meetingsTaskId) {
             taskItem = std::make_unique<model::TaskItemModel>(taskItemsTaskItemId,
-                taskItemsDuration,
+                common::Duration::Parse(taskItemsDuration),
                 taskItemsDescription,
                 taskItemsDateCreated,
                 taskItemsDateModified,
                 taskItemsIsActive);
 
-            if (taskItemsStartTime == nullptr && taskItemsEndTime == nullptr) {
-                taskItem->SetDurationTime(wxString(taskItemsDuration));
-            }
-
             if (taskItemsStartTime != nullptr && taskItemsEndTime != nullptr) {
                 taskItem->SetStartTime(wxString(*taskItemsStartTime));
                 taskItem->SetEndTime(wxString(*taskItemsEndTime));
@@ -241,7 +241,7 @@ void TaskItemData::Delete(int taskItemId)
     *pConnection->DatabaseExecutableHandle() << TaskItemData::deleteTaskItem << util::UnixTimestamp() << taskItemId;
 }
 
-std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByDate(const wxString& date)
+std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByDate(common::CivilDate date)
 {
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
 
@@ -295,16 +295,12 @@ std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByDate(const
             std::unique_ptr<bool> meetingsIsActive,
             std::unique_ptr<int> meetingsTaskId) {
             auto taskItem = std::make_unique<model::TaskItemModel>(taskItemsTaskItemId,
-                taskItemsDuration,
+                common::Duration::Parse(taskItemsDuration),
                 taskItemsDescription,
                 taskItemsDateCreated,
                 taskItemsDateModified,
                 taskItemsIsActive);
 
-            if (taskItemsStartTime == nullptr && taskItemsEndTime == nullptr) {
-                taskItem->SetDurationTime(wxString(taskItemsDuration));
-            }
-
             if (taskItemsStartTime != nullptr && taskItemsEndTime != nullptr) {
                 taskItem->SetStartTime(wxString(*taskItemsStartTime));
                 taskItem->SetEndTime(wxString(*taskItemsEndTime));
@@ -379,12 +375,12 @@ std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByDate(const
     return taskItems;
 }
 
-std::vector<wxString> TaskItemData::GetHours(const wxString& date)
+std::vector<common::Duration> TaskItemData::GetHours(common::CivilDate date)
 {
-    std::vector<wxString> taskDurations;
+    std::vector<common::Duration> taskDurations;
 
     *pConnection->DatabaseExecutableHandle() << TaskItemData::getTaskHoursByTaskId << date.ToStdString() >>
-        [&](std::string duration) { taskDurations.push_back(wxString(duration)); };
+        [&](std::string duration) { taskDurations.push_back(common::Duration::Parse(duration)); };
 
     return taskDurations;
 }
@@ -398,8 +394,8 @@ int TaskItemData::GetTaskItemTypeIdByTaskItemId(const int taskItemId)
     return taskItemTypeId;
 }
 
-std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByWeek(const wxString& fromDate,
-    const wxString& toDate)
+std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByWeek(common::CivilDate fromDate,
+    common::CivilDate toDate)
 {
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
     std::vector<int> taskItemIds;
@@ -423,13 +419,13 @@ wxString TaskItemData::GetDescriptionById(const int taskItemId)
     return rDescription;
 }
 
-std::vector<wxString> TaskItemData::GetHoursByWeek(const wxString& fromDate, const wxString& toDate)
+std::vector<common::Duration> TaskItemData::GetHoursByWeek(common::CivilDate fromDate, common::CivilDate toDate)
 {
-    std::vector<wxString> taskDurations;
+    std::vector<common::Duration> taskDurations;
 
     *pConnection->DatabaseExecutableHandle()
             << TaskItemData::getTaskHoursByWeek << fromDate.ToStdString() << toDate.ToStdString() >>
-        [&](std::string duration) { taskDurations.push_back(wxString(duration)); };
+        [&](std::string duration) { taskDurations.push_back(common::Duration::Parse(duration)); };
 
     return taskDurations;
 }
@@ -439,11 +435,20 @@ void TaskItemData::UpdateTaskItemWithMeetingId(const int64_t taskItemId, const i
     *pConnection->DatabaseExecutableHandle() << TaskItemData::updateTaskItemWithMeetingId << meetingId << taskItemId;
 }
 
+int TaskItemData::GetDataVersion()
+{
+    int dataVersion = 0;
+    *pConnection->DatabaseExecutableHandle() << TaskItemData::getDataVersion >>
+        [&](int version) { dataVersion = version; };
+    return dataVersion;
+}
+
 const std::string TaskItemData::createTaskItem = "INSERT INTO task_items "
                                                  "(start_time, end_time, duration, description, "
                                                  "billable, calculated_rate, is_active, "
-                                                 "task_item_type_id, project_id, category_id, task_id, meeting_id) "
-                                                 "VALUES (?, ?, ?, ?, ?, ?, 1, ?, ?, ?, ?, ?)";
+                                                 "task_item_type_id, project_id, category_id, task_id, meeting_id, "
+                                                 "date_created, date_modified) "
+                                                 "VALUES (?, ?, ?, ?, ?, ?, 1, ?, ?, ?, ?, ?, ?, ?)";
 
 const std::string TaskItemData::getTaskItemById = "SELECT "
                                                   "  task_items.task_item_id "
@@ -615,4 +620,6 @@ const std::string TaskItemData::getTaskHoursByWeek = "SELECT task_items.duration
 const std::string TaskItemData::updateTaskItemWithMeetingId = "UPDATE task_items "
                                                               "SET meeting_id = ? "
                                                               "WHERE task_item_id = ?";
+
+const std::string TaskItemData::getDataVersion = "PRAGMA data_version";
 } // namespace app::data
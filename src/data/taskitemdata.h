@@ -23,6 +23,7 @@
 
 #include <wx/string.h>
 
+#include "../common/civildate.h"
 #include "../database/connectionprovider.h"
 #include "../database/sqliteconnection.h"
 #include "../models/TaskItemModel.h"
@@ -40,13 +41,14 @@ class TaskItemData final
     void Update(std::unique_ptr<model::TaskItemModel> taskItem);
     void Delete(std::unique_ptr<model::TaskItemModel> taskItem);
     void Delete(int taskItemId);
-    std::vector<std::unique_ptr<model::TaskItemModel>> GetByDate(const wxString& date);
-    std::vector<wxString> GetHours(const wxString& date);
+    std::vector<std::unique_ptr<model::TaskItemModel>> GetByDate(common::CivilDate date);
+    std::vector<common::Duration> GetHours(common::CivilDate date);
     int GetTaskItemTypeIdByTaskItemId(const int taskItemId);
-    std::vector<std::unique_ptr<model::TaskItemModel>> GetByWeek(const wxString& fromDate, const wxString& toDate);
+    std::vector<std::unique_ptr<model::TaskItemModel>> GetByWeek(common::CivilDate fromDate, common::CivilDate toDate);
     wxString GetDescriptionById(const int taskItemId);
-    std::vector<wxString> GetHoursByWeek(const wxString& fromDate, const wxString& toDate);
+    std::vector<common::Duration> GetHoursByWeek(common::CivilDate fromDate, common::CivilDate toDate);
     void UpdateTaskItemWithMeetingId(const int64_t taskItemId, const int64_t meetingId);
+    int GetDataVersion();
 
 private:
     std::shared_ptr<db::SqliteConnection> pConnection;
@@ -62,5 +64,6 @@ class TaskItemData final
     static const std::string getDescriptionById;
     static const std::string getTaskHoursByWeek;
     static const std::string updateTaskItemWithMeetingId;
+    static const std::string getDataVersion;
 };
 }
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sqlite_modern_cpp.h>
@@ -41,6 +42,9 @@ class ConnectionPool final
     std::shared_ptr<T> Acquire();
     void Release(std::shared_ptr<T> connection);
 
+    /* Opens connections up to the pool size, meant for a background thread once startup is out of the way */
+    void Prefill();
+
     const std::size_t ConnectionsInUse() const;
 
 private:
@@ -48,6 +52,9 @@ class ConnectionPool final
     std::size_t mConnectionsInUse;
     std::shared_ptr<IConnectionFactory> pFactory;
     std::deque<std::shared_ptr<IConnection>> mPool;
+
+    /* Worker threads acquire and release connections alongside the UI thread */
+    mutable std::mutex mMutex;
 };
 
 template<class T>
@@ -57,7 +64,8 @@ inline ConnectionPool<T>::ConnectionPool(std::shared_ptr<IConnectionFactory> fac
     , mPool()
     , mConnectionsInUse(0)
 {
-    while (mPool.size() < mPoolSize) {
+    /* only the connection the first screen needs is opened up front, the rest come from Prefill or on demand */
+    if (mPoolSize > 0) {
         mPool.push_back(pFactory->Create());
     }
 }
@@ -71,6 +79,8 @@ inline ConnectionPool<T>::~ConnectionPool()
 template<class T>
 inline std::shared_ptr<T> ConnectionPool<T>::Acquire()
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+
     mConnectionsInUse++;
     assert(mConnectionsInUse <= mPoolSize);
 
@@ -89,13 +99,39 @@ inline std::shared_ptr<T> ConnectionPool<T>::Acquire()
 template<class T>
 inline void ConnectionPool<T>::Release(std::shared_ptr<T> connection)
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+
     mPool.push_back(std::dynamic_pointer_cast<IConnection>(connection));
     mConnectionsInUse--;
 }
 
+template<class T>
+inline void ConnectionPool<T>::Prefill()
+{
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mPool.size() + mConnectionsInUse >= mPoolSize) {
+                return;
+            }
+        }
+
+        /* opened outside the lock so Acquire is never held up behind a connection being opened */
+        auto connection = pFactory->Create();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mPool.size() + mConnectionsInUse >= mPoolSize) {
+            return;
+        }
+        mPool.push_back(connection);
+    }
+}
+
 template<class T>
 inline const std::size_t ConnectionPool<T>::ConnectionsInUse() const
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+
     return mConnectionsInUse;
 }
 } // namespace app::db
@@ -36,36 +36,45 @@ wxString DayDateLabels[7] = {
     wxT("Sunday %s"),
 };
 
-WeeklyTreeModelNode::WeeklyTreeModelNode(WeeklyTreeModelNode* parent,
-    const wxString& projectName,
-    const wxString& duration,
-    const wxString& categoryName,
-    const wxString& description,
-    int taskItemId)
-    : pParent(parent)
-    , mProjectName(projectName)
-    , mDuration(duration)
-    , mCategoryName(categoryName)
-    , mDescription(description)
-    , mTaskItemId(taskItemId)
+WeeklyTreeModelNode::WeeklyTreeModelNode()
+    : pParent(nullptr)
+    , mChildren()
+    , mProjectName(wxGetEmptyString())
+    , mDuration()
+    , mCategoryName(wxGetEmptyString())
+    , mDescription(wxGetEmptyString())
+    , mTaskItemId(-1)
     , bContainer(false)
 {
 }
 
-WeeklyTreeModelNode::WeeklyTreeModelNode(WeeklyTreeModelNode* parent, const wxString& branch)
-    : pParent(parent)
-    , mProjectName(branch)
-    , bContainer(true)
+void WeeklyTreeModelNode::Assign(WeeklyTreeModelNode* parent,
+    const wxString& projectName,
+    common::Duration duration,
+    const wxString& categoryName,
+    const wxString& description,
+    int taskItemId)
 {
+    pParent = parent;
+    mChildren.clear();
+    mProjectName = projectName;
+    mDuration = duration;
+    mCategoryName = categoryName;
+    mDescription = description;
+    mTaskItemId = taskItemId;
+    bContainer = false;
 }
 
-WeeklyTreeModelNode::~WeeklyTreeModelNode()
+void WeeklyTreeModelNode::Assign(WeeklyTreeModelNode* parent, const wxString& branch)
 {
-    std::size_t count = mChildren.GetCount();
-    for (std::size_t i = 0; i < count; i++) {
-        WeeklyTreeModelNode* child = mChildren[i];
-        delete child;
-    }
+    pParent = parent;
+    mChildren.clear();
+    mProjectName = branch;
+    mDuration = common::Duration();
+    mCategoryName.clear();
+    mDescription.clear();
+    mTaskItemId = -1;
+    bContainer = true;
 }
 
 bool WeeklyTreeModelNode::IsContainer() const
@@ -78,29 +87,37 @@ WeeklyTreeModelNode* WeeklyTreeModelNode::GetParent()
     return pParent;
 }
 
-WeeklyTreeModelNodePtrArray& WeeklyTreeModelNode::GetChildren()
+std::vector<WeeklyTreeModelNode*>& WeeklyTreeModelNode::GetChildren()
 {
     return mChildren;
 }
 
 WeeklyTreeModelNode* WeeklyTreeModelNode::GetNthChild(unsigned int n)
 {
-    return mChildren.Item(n);
+    return mChildren[n];
 }
 
 void WeeklyTreeModelNode::Insert(WeeklyTreeModelNode* child, unsigned int n)
 {
-    mChildren.Insert(child, n);
+    mChildren.insert(mChildren.begin() + n, child);
 }
 
 void WeeklyTreeModelNode::Append(WeeklyTreeModelNode* child)
 {
-    mChildren.Add(child);
+    mChildren.push_back(child);
+}
+
+void WeeklyTreeModelNode::Remove(WeeklyTreeModelNode* child)
+{
+    auto iterator = std::find(mChildren.begin(), mChildren.end(), child);
+    if (iterator != mChildren.end()) {
+        mChildren.erase(iterator);
+    }
 }
 
 const unsigned int WeeklyTreeModelNode::GetChildCount() const
 {
-    return mChildren.Count();
+    return static_cast<unsigned int>(mChildren.size());
 }
 
 wxString WeeklyTreeModelNode::GetProjectName() const
@@ -108,7 +125,7 @@ wxString WeeklyTreeModelNode::GetProjectName() const
     return mProjectName;
 }
 
-wxString WeeklyTreeModelNode::GetDuration() const
+common::Duration WeeklyTreeModelNode::GetDuration() const
 {
     return mDuration;
 }
@@ -133,7 +150,7 @@ void WeeklyTreeModelNode::SetProjectName(const wxString& value)
     mProjectName = value;
 }
 
-void WeeklyTreeModelNode::SetDuration(const wxString& value)
+void WeeklyTreeModelNode::SetDuration(common::Duration value)
 {
     mDuration = value;
 }
@@ -153,49 +170,74 @@ void WeeklyTreeModelNode::SetTaskItemId(int taskItemId)
     mTaskItemId = taskItemId;
 }
 
+// WeeklyTreeModelNodePool
+WeeklyTreeModelNodePool::WeeklyTreeModelNodePool()
+    : mChunks()
+    , mUsed(0)
+{
+}
+
+WeeklyTreeModelNode* WeeklyTreeModelNodePool::Acquire()
+{
+    std::size_t chunkIndex = mUsed / ChunkSize;
+    if (chunkIndex == mChunks.size()) {
+        mChunks.push_back(std::make_unique<WeeklyTreeModelNode[]>(ChunkSize));
+    }
+
+    WeeklyTreeModelNode* node = &mChunks[chunkIndex][mUsed % ChunkSize];
+    mUsed++;
+
+    return node;
+}
+
+void WeeklyTreeModelNodePool::Reset()
+{
+    mUsed = 0;
+}
+
 const wxString WeekLabel = wxT("Monday %s - Sunday %s");
 // WeeklyTreeModel
 WeeklyTreeModel::WeeklyTreeModel(const DateTraverser& dateTraverser)
-    : mWeeklyTasksMap()
+    : mContainerNodePool()
+    , mTaskItemNodePool()
+    , pRoot(nullptr)
     , pDayNodes()
     , mDateTraverser(dateTraverser)
 {
     SetupNodes();
 }
 
-WeeklyTreeModel::~WeeklyTreeModel()
+// This method should only be used from WeeklyTaskViewDialog once the week's nodes are cleared
+void WeeklyTreeModel::AddToWeek(const std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems)
 {
-    delete pRoot;
-}
+    common::CivilDate mondayDate = mDateTraverser.GetDay(constants::Days::Monday);
+    std::array<wxDataViewItemArray, NumberOfDays> itemsAdded;
 
-// This method should only be used once from WeeklyTaskViewDialog::FillControls
-void WeeklyTreeModel::AddToWeek(std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems)
-{
-    for (auto& taskItem : taskItems) {
-        wxString taskDateIndex = taskItem->GetTask()->GetTaskDate();
-        mWeeklyTasksMap[taskDateIndex].push_back(std::move(taskItem));
-    }
-
-    auto& mondayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Monday)];
-    AddMany(pDayNodes[constants::Days::Monday], mondayTaskItems);
-
-    auto& tuesdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Tuesday)];
-    AddMany(pDayNodes[constants::Days::Tuesday], tuesdayTaskItems);
-
-    auto& wednesdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Wednesday)];
-    AddMany(pDayNodes[constants::Days::Wednesday], wednesdayTaskItems);
+    for (const auto& taskItem : taskItems) {
+        int dayIndex = common::CivilDate::Parse(taskItem->GetTask()->GetTaskDate()) - mondayDate;
+        if (dayIndex < 0 || dayIndex >= NumberOfDays) {
+            continue;
+        }
 
-    auto& thursdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Thursday)];
-    AddMany(pDayNodes[constants::Days::Thursday], thursdayTaskItems);
+        WeeklyTreeModelNode* dayNode = pDayNodes[dayIndex];
 
-    auto& fridayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Friday)];
-    AddMany(pDayNodes[constants::Days::Friday], fridayTaskItems);
+        WeeklyTreeModelNode* node = mTaskItemNodePool.Acquire();
+        node->Assign(dayNode,
+            taskItem->GetProject()->GetDisplayName(),
+            taskItem->GetDuration(),
+            taskItem->GetCategory()->GetName(),
+            taskItem->GetDescription(),
+            taskItem->GetTaskItemId());
 
-    auto& saturdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Saturday)];
-    AddMany(pDayNodes[constants::Days::Saturday], saturdayTaskItems);
+        dayNode->Append(node);
+        itemsAdded[dayIndex].Add(wxDataViewItem((void*) node));
+    }
 
-    auto& sundayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Sunday)];
-    AddMany(pDayNodes[constants::Days::Sunday], sundayTaskItems);
+    for (std::size_t i = 0; i < NumberOfDays; i++) {
+        if (!itemsAdded[i].IsEmpty()) {
+            ItemsAdded(wxDataViewItem((void*) pDayNodes[i]), itemsAdded[i]);
+        }
+    }
 }
 
 unsigned int WeeklyTreeModel::GetColumnCount() const
@@ -222,7 +264,7 @@ void WeeklyTreeModel::GetValue(wxVariant& variant, const wxDataViewItem& item, u
         variant = node->GetProjectName();
         break;
     case Col_Duration:
-        variant = node->GetDuration();
+        variant = node->IsContainer() ? wxGetEmptyString() : node->GetDuration().ToString();
         break;
     case Col_Category:
         variant = node->GetCategoryName();
@@ -250,7 +292,7 @@ bool WeeklyTreeModel::SetValue(const wxVariant& variant, const wxDataViewItem& i
         node->SetProjectName(variant.GetString());
         break;
     case Col_Duration:
-        node->SetDuration(variant.GetString());
+        node->SetDuration(common::Duration::Parse(variant.GetString()));
         break;
     case Col_Category:
         node->SetCategoryName(variant.GetString());
@@ -312,13 +354,67 @@ unsigned int WeeklyTreeModel::GetChildren(const wxDataViewItem& parent, wxDataVi
         return 0;
     }
 
-    unsigned int count = node->GetChildren().GetCount();
-    for (unsigned int pos = 0; pos < count; pos++) {
-        WeeklyTreeModelNode* child = node->GetChildren().Item(pos);
+    for (auto child : node->GetChildren()) {
         array.Add(wxDataViewItem((void*) child));
     }
 
-    return count;
+    return node->GetChildCount();
+}
+
+void WeeklyTreeModel::Change(int taskItemId,
+    const wxString& taskDate,
+    const wxString& projectName,
+    common::Duration duration,
+    const wxString& categoryName,
+    const wxString& description)
+{
+    WeeklyTreeModelNode* node = FindTaskItemNode(taskItemId);
+
+    /* The edit may have moved the task to another day of the week, or out of the week altogether */
+    int dayIndex = common::CivilDate::Parse(taskDate) - mDateTraverser.GetDay(constants::Days::Monday);
+    if (dayIndex < 0 || dayIndex >= NumberOfDays) {
+        if (node) {
+            Delete(wxDataViewItem((void*) node));
+        }
+        return;
+    }
+
+    WeeklyTreeModelNode* dayNode = pDayNodes[dayIndex];
+    if (!node) {
+        node = mTaskItemNodePool.Acquire();
+        node->Assign(dayNode, projectName, duration, categoryName, description, taskItemId);
+        dayNode->Append(node);
+        ItemAdded(wxDataViewItem((void*) dayNode), wxDataViewItem((void*) node));
+        return;
+    }
+
+    if (node->GetParent() == dayNode) {
+        node->SetProjectName(projectName);
+        node->SetDuration(duration);
+        node->SetCategoryName(categoryName);
+        node->SetDescription(description);
+
+        ItemChanged(wxDataViewItem((void*) node));
+        return;
+    }
+
+    WeeklyTreeModelNode* previousDayNode = node->GetParent();
+    previousDayNode->Remove(node);
+    ItemDeleted(wxDataViewItem((void*) previousDayNode), wxDataViewItem((void*) node));
+
+    node->Assign(dayNode, projectName, duration, categoryName, description, taskItemId);
+    dayNode->Append(node);
+    ItemAdded(wxDataViewItem((void*) dayNode), wxDataViewItem((void*) node));
+}
+
+void WeeklyTreeModel::Delete(int taskItemId)
+{
+    WeeklyTreeModelNode* node = FindTaskItemNode(taskItemId);
+    if (!node) {
+        return;
+    }
+
+    Delete(wxDataViewItem((void*) node));
 }
 
 void WeeklyTreeModel::Delete(const wxDataViewItem& item)
@@ -340,8 +436,8 @@ void WeeklyTreeModel::Delete(const wxDataViewItem& item)
         }
     }
 
-    node->GetParent()->GetChildren().Remove(node);
-    delete node;
+    /* The node stays in the pool until the next week is loaded */
+    node->GetParent()->Remove(node);
 
     ItemDeleted(parent, item);
 }
@@ -353,6 +449,8 @@ void WeeklyTreeModel::ClearAll()
     for (std::size_t i = 0; i < NumberOfDays; i++) {
         ClearDayNodes(pDayNodes[i]);
     }
+
+    mTaskItemNodePool.Reset();
 }
 
 wxDataViewItem WeeklyTreeModel::ExpandRootNode()
@@ -373,23 +471,13 @@ wxDateTime WeeklyTreeModel::GetDateFromDataViewItem(const wxDataViewItem& item)
 {
     WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
 
-    if (node->GetParent() == pDayNodes[constants::Days::Monday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Monday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Tuesday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Tuesday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Wednesday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Wednesday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Thursday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Thursday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Friday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Friday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Saturday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Saturday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Sunday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Sunday);
-    } else {
-        return wxDateTime::Now();
+    for (std::size_t i = 0; i < NumberOfDays; i++) {
+        if (node->GetParent() == pDayNodes[i]) {
+            return mDateTraverser.GetDayDate(constants::MapIndexToEnum(i));
+        }
     }
+
+    return wxDateTime::Now();
 }
 
 void WeeklyTreeModel::SetDateTraverser(const DateTraverser& dateTraverser)
@@ -403,53 +491,47 @@ void WeeklyTreeModel::SetupNodes()
         mDateTraverser.GetDayISODate(constants::Days::Monday),
         mDateTraverser.GetDayISODate(constants::Days::Sunday));
 
-    pRoot = new WeeklyTreeModelNode(nullptr, weekLabel);
+    pRoot = mContainerNodePool.Acquire();
+    pRoot->Assign(nullptr, weekLabel);
 
     for (std::size_t i = 0; i < NumberOfDays; i++) {
         wxString label = wxString::Format(DayDateLabels[i], mDateTraverser.GetDayISODate(constants::MapIndexToEnum(i)));
-        pDayNodes[i] = new WeeklyTreeModelNode(pRoot, label);
+        pDayNodes[i] = mContainerNodePool.Acquire();
+        pDayNodes[i]->Assign(pRoot, label);
         pRoot->Append(pDayNodes[i]);
     }
 }
 
-void WeeklyTreeModel::AddMany(WeeklyTreeModelNode* dayNodeToAdd,
-    std::vector<std::unique_ptr<model::TaskItemModel>>& dayTasksToAdd)
-{
-    for (const auto& taskToAdd : dayTasksToAdd) {
-        auto node = new WeeklyTreeModelNode(dayNodeToAdd,
-            taskToAdd->GetProject()->GetDisplayName(),
-            taskToAdd->GetDuration(),
-            taskToAdd->GetCategory()->GetName(),
-            taskToAdd->GetDescription(),
-            taskToAdd->GetTaskItemId());
-
-        dayNodeToAdd->Append(node);
-    }
-}
-
 void WeeklyTreeModel::ClearDayNodes(WeeklyTreeModelNode* node)
 {
-    wxDataViewItemArray itemsRemoved;
-    unsigned int count = node->GetChildCount();
-
-    for (unsigned int pos = 0; pos < count; pos++) {
-        WeeklyTreeModelNode* child = node->GetChildren().Item(pos);
-        itemsRemoved.Add(wxDataViewItem((void*) child));
+    if (node->GetChildCount() == 0) {
+        return;
     }
 
+    wxDataViewItemArray itemsRemoved;
     for (auto child : node->GetChildren()) {
-        delete child;
-        child = nullptr;
+        itemsRemoved.Add(wxDataViewItem((void*) child));
     }
 
     node->GetChildren().clear();
 
-    count = node->GetChildCount();
-
     wxDataViewItem parent((void*) node);
     ItemsDeleted(parent, itemsRemoved);
 }
 
+WeeklyTreeModelNode* WeeklyTreeModel::FindTaskItemNode(int taskItemId)
+{
+    for (std::size_t i = 0; i < NumberOfDays; i++) {
+        for (auto child : pDayNodes[i]->GetChildren()) {
+            if (child->GetTaskItemId() == taskItemId) {
+                return child;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
 void WeeklyTreeModel::UpdateNodeLabels()
 {
     wxString weekLabel = wxString::Format(WeekLabel,
@@ -457,9 +539,12 @@ void WeeklyTreeModel::UpdateNodeLabels()
         mDateTraverser.GetDayISODate(constants::Days::Sunday));
 
     pRoot->SetProjectName(weekLabel);
+    ItemChanged(wxDataViewItem((void*) pRoot));
+
     for (std::size_t i = 0; i < NumberOfDays; i++) {
         wxString label = wxString::Format(DayDateLabels[i], mDateTraverser.GetDayISODate(constants::MapIndexToEnum(i)));
         pDayNodes[i]->SetProjectName(label);
+        ItemChanged(wxDataViewItem((void*) pDayNodes[i]));
     }
 }
 } // namespace app::dv
@@ -20,76 +20,100 @@
 #pragma once
 
 #include <array>
-#include <unordered_map>
+#include <memory>
 #include <vector>
 
 #include <wx/wx.h>
 #include <wx/dataview.h>
 
 #include "../common/datetraverser.h"
+#include "../common/duration.h"
 #include "../models/taskitemmodel.h"
 
 namespace app::dv
 {
 const int NumberOfDays = 7;
 
-class WeeklyTreeModelNode;
-WX_DEFINE_ARRAY_PTR(WeeklyTreeModelNode*, WeeklyTreeModelNodePtrArray);
-
 class WeeklyTreeModelNode final
 {
 public:
-    WeeklyTreeModelNode(WeeklyTreeModelNode* parent,
+    WeeklyTreeModelNode();
+    ~WeeklyTreeModelNode() = default;
+
+    void Assign(WeeklyTreeModelNode* parent,
         const wxString& projectName,
-        const wxString& duration,
+        common::Duration duration,
         const wxString& categoryName,
         const wxString& description,
         int taskItemId);
-    WeeklyTreeModelNode(WeeklyTreeModelNode* parent, const wxString& branch);
-    ~WeeklyTreeModelNode();
+    void Assign(WeeklyTreeModelNode* parent, const wxString& branch);
 
     bool IsContainer() const;
     WeeklyTreeModelNode* GetParent();
-    WeeklyTreeModelNodePtrArray& GetChildren();
+    std::vector<WeeklyTreeModelNode*>& GetChildren();
     WeeklyTreeModelNode* GetNthChild(unsigned int n);
 
     void Insert(WeeklyTreeModelNode* child, unsigned int n);
     void Append(WeeklyTreeModelNode* child);
+    void Remove(WeeklyTreeModelNode* child);
     const unsigned int GetChildCount() const;
 
     wxString GetProjectName() const;
-    wxString GetDuration() const;
+    common::Duration GetDuration() const;
     wxString GetCategoryName() const;
     wxString GetDescription() const;
     int GetTaskItemId() const;
 
     void SetProjectName(const wxString& value);
-    void SetDuration(const wxString& value);
+    void SetDuration(common::Duration value);
     void SetCategoryName(const wxString& value);
     void SetDescription(const wxString& value);
     void SetTaskItemId(int taskItemId);
 
 private:
     WeeklyTreeModelNode* pParent;
-    WeeklyTreeModelNodePtrArray mChildren;
+    std::vector<WeeklyTreeModelNode*> mChildren;
 
     wxString mProjectName;
-    wxString mDuration;
+    common::Duration mDuration;
     wxString mCategoryName;
     wxString mDescription;
     int mTaskItemId;
     bool bContainer;
 };
 
+/*
+ * Hands out nodes from fixed size chunks so a week of task items lives in a few contiguous blocks.
+ * Reset() recycles every node (and its string buffers) for the next week without freeing the chunks.
+ */
+class WeeklyTreeModelNodePool final
+{
+public:
+    WeeklyTreeModelNodePool();
+    WeeklyTreeModelNodePool(const WeeklyTreeModelNodePool&) = delete;
+    ~WeeklyTreeModelNodePool() = default;
+
+    WeeklyTreeModelNodePool& operator=(const WeeklyTreeModelNodePool&) = delete;
+
+    WeeklyTreeModelNode* Acquire();
+    void Reset();
+
+private:
+    static constexpr std::size_t ChunkSize = 64;
+
+    std::vector<std::unique_ptr<WeeklyTreeModelNode[]>> mChunks;
+    std::size_t mUsed;
+};
+
 class WeeklyTreeModel : public wxDataViewModel
 {
 public:
     enum { Col_Project = 0, Col_Duration, Col_Category, Col_Description, Col_Id, Col_Max };
 
     WeeklyTreeModel(const DateTraverser& dateTraverser);
-    ~WeeklyTreeModel();
+    ~WeeklyTreeModel() = default;
 
-    void AddToWeek(std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems);
+    void AddToWeek(const std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems);
 
     unsigned int GetColumnCount() const override;
     wxString GetColumnType(unsigned int col) const override;
@@ -99,6 +123,13 @@ class WeeklyTreeModel : public wxDataViewModel
     wxDataViewItem GetParent(const wxDataViewItem& item) const override;
     bool IsContainer(const wxDataViewItem& item) const override;
     unsigned int GetChildren(const wxDataViewItem& parent, wxDataViewItemArray& array) const override;
+    void Change(int taskItemId,
+        const wxString& taskDate,
+        const wxString& projectName,
+        common::Duration duration,
+        const wxString& categoryName,
+        const wxString& description);
+    void Delete(int taskItemId);
     void Delete(const wxDataViewItem& item);
     void ClearAll();
 
@@ -111,12 +142,14 @@ class WeeklyTreeModel : public wxDataViewModel
 private:
     void SetupNodes();
 
-    void AddMany(WeeklyTreeModelNode* dayNodeToAdd, std::vector<std::unique_ptr<model::TaskItemModel>>& dayTasksToAdd);
     void ClearDayNodes(WeeklyTreeModelNode* node);
+    WeeklyTreeModelNode* FindTaskItemNode(int taskItemId);
 
     void UpdateNodeLabels();
 
-    std::unordered_map<wxString, std::vector<std::unique_ptr<model::TaskItemModel>>> mWeeklyTasksMap;
+    /* Root and day nodes live for the lifetime of the model, task item nodes are recycled every week */
+    WeeklyTreeModelNodePool mContainerNodePool;
+    WeeklyTreeModelNodePool mTaskItemNodePool;
 
     WeeklyTreeModelNode* pRoot;
     std::array<WeeklyTreeModelNode*, NumberOfDays> pDayNodes;
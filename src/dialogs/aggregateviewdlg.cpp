@@ -0,0 +1,503 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "aggregateviewdlg.h"
+
+#include <algorithm>
+
+#include <sqlite_modern_cpp/errors.h>
+#include <wx/dcbuffer.h>
+
+#include "../common/common.h"
+#include "../common/constants.h"
+#include "../common/duration.h"
+
+namespace app::dlg
+{
+const int CellGap = 2;
+const int DaysInWeek = 7;
+
+CalendarHeatmap::CalendarHeatmap(wxWindow* parent, wxWindowID windowId)
+    : wxPanel(parent, windowId, wxDefaultPosition, wxSize(-1, 140))
+    , mFromDate(common::CivilDate::Today())
+    , mFirstWeekday(0)
+    , mMaxSeconds(0)
+    , mHoverDayIndex(-1)
+    , mDaySeconds()
+{
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+    // clang-format off
+    Bind(
+        wxEVT_PAINT,
+        &CalendarHeatmap::OnPaint,
+        this
+    );
+
+    Bind(
+        wxEVT_MOTION,
+        &CalendarHeatmap::OnMotion,
+        this
+    );
+
+    Bind(
+        wxEVT_SIZE,
+        &CalendarHeatmap::OnResize,
+        this
+    );
+    // clang-format on
+}
+
+void CalendarHeatmap::SetDayTotals(common::CivilDate fromDate,
+    common::CivilDate toDate,
+    const std::vector<data::DayTotal>& dayTotals)
+{
+    mFromDate = fromDate;
+    mFirstWeekday = fromDate.GetDayOfWeek();
+    mMaxSeconds = 0;
+    mHoverDayIndex = -1;
+
+    int days = toDate - fromDate + 1;
+    mDaySeconds.assign(days, 0);
+
+    for (const auto& dayTotal : dayTotals) {
+        int dayIndex = dayTotal.Date - fromDate;
+        if (dayIndex < 0 || dayIndex >= days) {
+            continue;
+        }
+
+        mDaySeconds[dayIndex] = dayTotal.Seconds;
+        mMaxSeconds = std::max(mMaxSeconds, dayTotal.Seconds);
+    }
+
+    UnsetToolTip();
+    Refresh();
+}
+
+void CalendarHeatmap::OnPaint(wxPaintEvent& WXUNUSED(event))
+{
+    wxAutoBufferedPaintDC dc(this);
+    dc.SetBackground(wxBrush(GetParent()->GetBackgroundColour()));
+    dc.Clear();
+
+    int cellSize = GetCellSize();
+    dc.SetPen(*wxTRANSPARENT_PEN);
+
+    for (std::size_t i = 0; i < mDaySeconds.size(); i++) {
+        int slot = mFirstWeekday + static_cast<int>(i);
+        int x = CellGap + (slot / DaysInWeek) * (cellSize + CellGap);
+        int y = CellGap + (slot % DaysInWeek) * (cellSize + CellGap);
+
+        dc.SetBrush(wxBrush(GetCellColor(mDaySeconds[i])));
+        dc.DrawRectangle(x, y, cellSize, cellSize);
+    }
+}
+
+void CalendarHeatmap::OnMotion(wxMouseEvent& event)
+{
+    int dayIndex = GetDayIndexAt(event.GetPosition());
+    if (dayIndex == mHoverDayIndex) {
+        return;
+    }
+
+    mHoverDayIndex = dayIndex;
+    if (dayIndex == -1) {
+        UnsetToolTip();
+        return;
+    }
+
+    char date[common::CivilDate::ISODateLength];
+    mFromDate.AddDays(dayIndex).FormatISODate(date);
+    common::Duration duration(mDaySeconds[dayIndex]);
+    SetToolTip(wxString::Format(wxT("%s: %s"), date, duration.ToString()));
+}
+
+void CalendarHeatmap::OnResize(wxSizeEvent& event)
+{
+    Refresh();
+    event.Skip();
+}
+
+int CalendarHeatmap::GetCellSize() const
+{
+    int weeks = (mFirstWeekday + static_cast<int>(mDaySeconds.size()) + DaysInWeek - 1) / DaysInWeek;
+    weeks = std::max(weeks, 1);
+
+    wxSize size = GetClientSize();
+    int cellWidth = (size.GetWidth() - CellGap) / weeks - CellGap;
+    int cellHeight = (size.GetHeight() - CellGap) / DaysInWeek - CellGap;
+
+    return std::max(std::min(cellWidth, cellHeight), 4);
+}
+
+int CalendarHeatmap::GetDayIndexAt(const wxPoint& position) const
+{
+    int cellSize = GetCellSize();
+    int stride = cellSize + CellGap;
+
+    if (position.x < CellGap || position.y < CellGap) {
+        return -1;
+    }
+
+    int column = (position.x - CellGap) / stride;
+    int row = (position.y - CellGap) / stride;
+    if (row >= DaysInWeek) {
+        return -1;
+    }
+
+    int dayIndex = column * DaysInWeek + row - mFirstWeekday;
+    if (dayIndex < 0 || dayIndex >= static_cast<int>(mDaySeconds.size())) {
+        return -1;
+    }
+
+    return dayIndex;
+}
+
+wxColor CalendarHeatmap::GetCellColor(int seconds) const
+{
+    if (seconds <= 0 || mMaxSeconds <= 0) {
+        return wxColor(235, 237, 240);
+    }
+
+    double ratio = static_cast<double>(seconds) / static_cast<double>(mMaxSeconds);
+    auto blend = [&](int from, int to) { return static_cast<unsigned char>(from + (to - from) * ratio); };
+
+    return wxColor(blend(198, 25), blend(228, 97), blend(139, 39));
+}
+
+AggregateViewDialog::AggregateViewDialog(wxWindow* parent,
+    std::shared_ptr<spdlog::logger> logger,
+    const wxString& name)
+    : pParent(parent)
+    , pLogger(logger)
+    , pPeriodChoiceCtrl(nullptr)
+    , pPrevPeriodButton(nullptr)
+    , pPeriodLabel(nullptr)
+    , pNextPeriodButton(nullptr)
+    , pCalendarHeatmap(nullptr)
+    , pTotalHoursLabel(nullptr)
+    , pWeekTotalsListCtrl(nullptr)
+    , pProjectTotalsListCtrl(nullptr)
+    , pCategoryTotalsListCtrl(nullptr)
+    , mPeriodStartDate(wxDateTime::Today())
+{
+    mPeriodStartDate.SetDay(1);
+
+    long style = wxCAPTION | wxCLOSE_BOX | wxMAXIMIZE_BOX | wxMINIMIZE_BOX | wxRESIZE_BORDER;
+    wxSize dialogSize = wxSize(960, 620);
+    Create(pParent, wxID_ANY, wxT("Month and Year View"), wxDefaultPosition, dialogSize, style, name);
+    SetMinSize(dialogSize);
+}
+
+bool AggregateViewDialog::Create(wxWindow* parent,
+    wxWindowID windowId,
+    const wxString& title,
+    const wxPoint& position,
+    const wxSize& size,
+    long style,
+    const wxString& name)
+{
+    bool created = wxDialog::Create(parent, windowId, title, position, size, style, name);
+    if (created) {
+        CreateControls();
+        ConfigureEventBindings();
+        FillControls();
+
+        wxIconBundle iconBundle("AppIcon", 0);
+        SetIcons(iconBundle);
+
+        Center();
+    }
+
+    return created;
+}
+
+void AggregateViewDialog::CreateControls()
+{
+    /* Main Window Sizer */
+    auto mainSizer = new wxBoxSizer(wxVERTICAL);
+    SetSizer(mainSizer);
+
+    /* Period Navigation Sizer */
+    auto navigationSizer = new wxBoxSizer(wxHORIZONTAL);
+    mainSizer->Add(navigationSizer, common::sizers::ControlExpand);
+
+    pPeriodChoiceCtrl = new wxChoice(this, IDC_PERIOD_CHOICE);
+    pPeriodChoiceCtrl->Append(wxT("Month"));
+    pPeriodChoiceCtrl->Append(wxT("Year"));
+    pPeriodChoiceCtrl->SetSelection(PeriodMonth);
+    pPeriodChoiceCtrl->SetToolTip(wxT("Select the period to total hours over"));
+    navigationSizer->Add(pPeriodChoiceCtrl, common::sizers::ControlCenterVertical);
+
+    navigationSizer->AddStretchSpacer();
+
+    pPrevPeriodButton = new wxButton(this, IDC_PREV_PERIOD, wxT("<"), wxDefaultPosition, wxSize(32, -1));
+    pPrevPeriodButton->SetToolTip(wxT("Go to the previous period"));
+    navigationSizer->Add(pPrevPeriodButton, common::sizers::ControlCenterVertical);
+
+    pPeriodLabel = new wxStaticText(
+        this, IDC_PERIOD_LABEL, wxGetEmptyString(), wxDefaultPosition, wxSize(140, -1), wxALIGN_CENTER_HORIZONTAL);
+    auto periodLabelFont = pPeriodLabel->GetFont();
+    periodLabelFont.MakeBold();
+    pPeriodLabel->SetFont(periodLabelFont);
+    navigationSizer->Add(pPeriodLabel, common::sizers::ControlCenterVertical);
+
+    pNextPeriodButton = new wxButton(this, IDC_NEXT_PERIOD, wxT(">"), wxDefaultPosition, wxSize(32, -1));
+    pNextPeriodButton->SetToolTip(wxT("Go to the next period"));
+    navigationSizer->Add(pNextPeriodButton, common::sizers::ControlCenterVertical);
+
+    /* Heatmap */
+    auto heatmapBox = new wxStaticBox(this, wxID_ANY, wxT("Hours Per Day"));
+    auto heatmapBoxSizer = new wxStaticBoxSizer(heatmapBox, wxVERTICAL);
+    mainSizer->Add(heatmapBoxSizer, common::sizers::ControlExpand);
+
+    pCalendarHeatmap = new CalendarHeatmap(heatmapBox, IDC_HEATMAP);
+    heatmapBoxSizer->Add(pCalendarHeatmap, common::sizers::ControlExpand);
+
+    /* Total Hours Label */
+    pTotalHoursLabel = new wxStaticText(this, IDC_TOTAL_HOURS, wxGetEmptyString());
+    pTotalHoursLabel->SetToolTip(wxT("Shows the total hours worked for the selected period"));
+    auto totalHoursLabelFont = pTotalHoursLabel->GetFont();
+    totalHoursLabelFont.SetPointSize(12);
+    totalHoursLabelFont.MakeBold();
+    pTotalHoursLabel->SetFont(totalHoursLabelFont);
+    mainSizer->Add(pTotalHoursLabel, common::sizers::ControlCenterHorizontal);
+
+    /* Totals Sizer */
+    auto totalsSizer = new wxBoxSizer(wxHORIZONTAL);
+    mainSizer->Add(totalsSizer, 1, wxEXPAND | wxALL, 5);
+
+    long listStyle = wxLC_REPORT | wxLC_SINGLE_SEL | wxLC_HRULES | wxLC_VRULES;
+
+    /* Week Totals */
+    auto weekTotalsBox = new wxStaticBox(this, wxID_ANY, wxT("Weeks"));
+    auto weekTotalsBoxSizer = new wxStaticBoxSizer(weekTotalsBox, wxVERTICAL);
+    totalsSizer->Add(weekTotalsBoxSizer, 1, wxEXPAND | wxALL, 5);
+
+    pWeekTotalsListCtrl = new wxListCtrl(
+        weekTotalsBox, IDC_WEEK_TOTALS, wxDefaultPosition, wxDefaultSize, listStyle);
+    pWeekTotalsListCtrl->InsertColumn(0, wxT("Week Of"), wxLIST_FORMAT_LEFT, 140);
+    pWeekTotalsListCtrl->InsertColumn(1, wxT("Hours"), wxLIST_FORMAT_CENTER, 100);
+    weekTotalsBoxSizer->Add(pWeekTotalsListCtrl, 1, wxEXPAND | wxALL, 5);
+
+    /* Project Totals */
+    auto projectTotalsBox = new wxStaticBox(this, wxID_ANY, wxT("Projects"));
+    auto projectTotalsBoxSizer = new wxStaticBoxSizer(projectTotalsBox, wxVERTICAL);
+    totalsSizer->Add(projectTotalsBoxSizer, 1, wxEXPAND | wxALL, 5);
+
+    pProjectTotalsListCtrl = new wxListCtrl(
+        projectTotalsBox, IDC_PROJECT_TOTALS, wxDefaultPosition, wxDefaultSize, listStyle);
+    pProjectTotalsListCtrl->InsertColumn(0, wxT("Project"), wxLIST_FORMAT_LEFT, 220);
+    pProjectTotalsListCtrl->InsertColumn(1, wxT("Hours"), wxLIST_FORMAT_CENTER, 100);
+    projectTotalsBoxSizer->Add(pProjectTotalsListCtrl, 1, wxEXPAND | wxALL, 5);
+
+    /* Category Totals */
+    auto categoryTotalsBox = new wxStaticBox(this, wxID_ANY, wxT("Categories"));
+    auto categoryTotalsBoxSizer = new wxStaticBoxSizer(categoryTotalsBox, wxVERTICAL);
+    totalsSizer->Add(categoryTotalsBoxSizer, 1, wxEXPAND | wxALL, 5);
+
+    pCategoryTotalsListCtrl = new wxListCtrl(
+        categoryTotalsBox, IDC_CATEGORY_TOTALS, wxDefaultPosition, wxDefaultSize, listStyle);
+    pCategoryTotalsListCtrl->InsertColumn(0, wxT("Category"), wxLIST_FORMAT_LEFT, 220);
+    pCategoryTotalsListCtrl->InsertColumn(1, wxT("Hours"), wxLIST_FORMAT_CENTER, 100);
+    categoryTotalsBoxSizer->Add(pCategoryTotalsListCtrl, 1, wxEXPAND | wxALL, 5);
+}
+
+// clang-format off
+void AggregateViewDialog::ConfigureEventBindings()
+{
+    pPeriodChoiceCtrl->Bind(
+        wxEVT_CHOICE,
+        &AggregateViewDialog::OnPeriodChoice,
+        this
+    );
+
+    pPrevPeriodButton->Bind(
+        wxEVT_BUTTON,
+        &AggregateViewDialog::OnPrevPeriod,
+        this
+    );
+
+    pNextPeriodButton->Bind(
+        wxEVT_BUTTON,
+        &AggregateViewDialog::OnNextPeriod,
+        this
+    );
+}
+// clang-format on
+
+void AggregateViewDialog::FillControls()
+{
+    wxBusyCursor wait;
+
+    common::CivilDate fromDate = common::CivilDate::FromDateTime(mPeriodStartDate);
+    common::CivilDate toDate = common::CivilDate::FromDateTime(GetPeriodEndDate());
+
+    if (pPeriodChoiceCtrl->GetSelection() == PeriodYear) {
+        pPeriodLabel->SetLabel(mPeriodStartDate.Format(wxT("%Y")));
+    } else {
+        pPeriodLabel->SetLabel(mPeriodStartDate.Format(wxT("%B %Y")));
+    }
+
+    data::AggregateData aggregateData;
+
+    std::vector<data::DayTotal> dayTotals;
+    try {
+        dayTotals = aggregateData.GetDayTotals(fromDate, toDate);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on AggregateData::GetDayTotals({0}, {1}) - {2:d} : {3}",
+            fromDate.ToStdString(),
+            toDate.ToStdString(),
+            e.get_code(),
+            e.what());
+    }
+
+    std::vector<data::WeekTotal> weekTotals;
+    try {
+        weekTotals = aggregateData.GetWeekTotals(fromDate, toDate);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on AggregateData::GetWeekTotals({0}, {1}) - {2:d} : {3}",
+            fromDate.ToStdString(),
+            toDate.ToStdString(),
+            e.get_code(),
+            e.what());
+    }
+
+    std::vector<data::ProjectTotal> projectTotals;
+    try {
+        projectTotals = aggregateData.GetProjectTotals(fromDate, toDate);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on AggregateData::GetProjectTotals({0}, {1}) - {2:d} : {3}",
+            fromDate.ToStdString(),
+            toDate.ToStdString(),
+            e.get_code(),
+            e.what());
+    }
+
+    std::vector<data::CategoryTotal> categoryTotals;
+    try {
+        categoryTotals = aggregateData.GetCategoryTotals(fromDate, toDate);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on AggregateData::GetCategoryTotals({0}, {1}) - {2:d} : {3}",
+            fromDate.ToStdString(),
+            toDate.ToStdString(),
+            e.get_code(),
+            e.what());
+    }
+
+    pCalendarHeatmap->SetDayTotals(fromDate, toDate, dayTotals);
+
+    common::Duration totalDuration;
+    for (const auto& dayTotal : dayTotals) {
+        totalDuration += common::Duration(dayTotal.Seconds);
+    }
+    pTotalHoursLabel->SetLabel(wxString::Format(constants::TotalHours, totalDuration.ToString()));
+
+    FillWeekTotals(weekTotals);
+    FillProjectTotals(projectTotals);
+    FillCategoryTotals(categoryTotals);
+
+    Layout();
+}
+
+void AggregateViewDialog::OnPeriodChoice(wxCommandEvent& event)
+{
+    if (event.GetSelection() == PeriodYear) {
+        mPeriodStartDate.SetMonth(wxDateTime::Jan);
+    } else {
+        wxDateTime today = wxDateTime::Today();
+        if (today.GetYear() == mPeriodStartDate.GetYear()) {
+            mPeriodStartDate.SetMonth(today.GetMonth());
+        }
+    }
+
+    FillControls();
+}
+
+void AggregateViewDialog::OnPrevPeriod(wxCommandEvent& WXUNUSED(event))
+{
+    MovePeriod(-1);
+}
+
+void AggregateViewDialog::OnNextPeriod(wxCommandEvent& WXUNUSED(event))
+{
+    MovePeriod(1);
+}
+
+void AggregateViewDialog::MovePeriod(int direction)
+{
+    if (pPeriodChoiceCtrl->GetSelection() == PeriodYear) {
+        mPeriodStartDate.Add(wxDateSpan::Years(direction));
+    } else {
+        mPeriodStartDate.Add(wxDateSpan::Months(direction));
+    }
+
+    FillControls();
+}
+
+wxDateTime AggregateViewDialog::GetPeriodEndDate() const
+{
+    if (pPeriodChoiceCtrl->GetSelection() == PeriodYear) {
+        return wxDateTime(31, wxDateTime::Dec, mPeriodStartDate.GetYear());
+    }
+
+    wxDateTime periodEndDate = mPeriodStartDate;
+    periodEndDate.SetToLastMonthDay(mPeriodStartDate.GetMonth(), mPeriodStartDate.GetYear());
+    return periodEndDate;
+}
+
+void AggregateViewDialog::FillWeekTotals(const std::vector<data::WeekTotal>& weekTotals)
+{
+    pWeekTotalsListCtrl->DeleteAllItems();
+
+    for (const auto& weekTotal : weekTotals) {
+        long listIndex = pWeekTotalsListCtrl->InsertItem(
+            pWeekTotalsListCtrl->GetItemCount(), weekTotal.WeekStart.ToStdString());
+        pWeekTotalsListCtrl->SetItem(
+            listIndex, 1, common::Duration(weekTotal.Seconds).ToString());
+    }
+}
+
+void AggregateViewDialog::FillProjectTotals(const std::vector<data::ProjectTotal>& projectTotals)
+{
+    pProjectTotalsListCtrl->DeleteAllItems();
+
+    for (const auto& projectTotal : projectTotals) {
+        long listIndex = pProjectTotalsListCtrl->InsertItem(
+            pProjectTotalsListCtrl->GetItemCount(), projectTotal.DisplayName);
+        pProjectTotalsListCtrl->SetItem(
+            listIndex, 1, common::Duration(projectTotal.Seconds).ToString());
+        pProjectTotalsListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(projectTotal.ProjectId));
+    }
+}
+
+void AggregateViewDialog::FillCategoryTotals(const std::vector<data::CategoryTotal>& categoryTotals)
+{
+    pCategoryTotalsListCtrl->DeleteAllItems();
+
+    for (const auto& categoryTotal : categoryTotals) {
+        long listIndex = pCategoryTotalsListCtrl->InsertItem(
+            pCategoryTotalsListCtrl->GetItemCount(), categoryTotal.Name);
+        pCategoryTotalsListCtrl->SetItem(
+            listIndex, 1, common::Duration(categoryTotal.Seconds).ToString());
+        pCategoryTotalsListCtrl->SetItemBackgroundColour(listIndex, categoryTotal.Color);
+        pCategoryTotalsListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(categoryTotal.CategoryId));
+    }
+}
+} // namespace app::dlg
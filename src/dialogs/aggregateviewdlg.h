@@ -0,0 +1,123 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../common/civildate.h"
+#include "../data/aggregatedata.h"
+
+namespace app::dlg
+{
+/* Paints one square per day laid out in Monday-first week columns, shaded by the hours logged */
+class CalendarHeatmap final : public wxPanel
+{
+public:
+    CalendarHeatmap() = delete;
+    CalendarHeatmap(wxWindow* parent, wxWindowID windowId = wxID_ANY);
+    virtual ~CalendarHeatmap() = default;
+
+    void SetDayTotals(common::CivilDate fromDate, common::CivilDate toDate, const std::vector<data::DayTotal>& dayTotals);
+
+private:
+    void OnPaint(wxPaintEvent& event);
+    void OnMotion(wxMouseEvent& event);
+    void OnResize(wxSizeEvent& event);
+
+    int GetCellSize() const;
+    int GetDayIndexAt(const wxPoint& position) const;
+    wxColor GetCellColor(int seconds) const;
+
+    common::CivilDate mFromDate;
+    int mFirstWeekday;
+    int mMaxSeconds;
+    int mHoverDayIndex;
+    std::vector<int> mDaySeconds;
+};
+
+class AggregateViewDialog final : public wxDialog
+{
+public:
+    AggregateViewDialog() = delete;
+    AggregateViewDialog(wxWindow* parent,
+        std::shared_ptr<spdlog::logger> logger,
+        const wxString& name = wxT("aggregateviewdlg"));
+    virtual ~AggregateViewDialog() = default;
+
+private:
+    bool Create(wxWindow* parent,
+        wxWindowID windowId,
+        const wxString& title,
+        const wxPoint& position,
+        const wxSize& size,
+        long style,
+        const wxString& name);
+
+    void CreateControls();
+    void ConfigureEventBindings();
+    void FillControls();
+
+    void OnPeriodChoice(wxCommandEvent& event);
+    void OnPrevPeriod(wxCommandEvent& event);
+    void OnNextPeriod(wxCommandEvent& event);
+
+    void MovePeriod(int direction);
+    wxDateTime GetPeriodEndDate() const;
+
+    void FillWeekTotals(const std::vector<data::WeekTotal>& weekTotals);
+    void FillProjectTotals(const std::vector<data::ProjectTotal>& projectTotals);
+    void FillCategoryTotals(const std::vector<data::CategoryTotal>& categoryTotals);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    wxWindow* pParent;
+    wxChoice* pPeriodChoiceCtrl;
+    wxButton* pPrevPeriodButton;
+    wxStaticText* pPeriodLabel;
+    wxButton* pNextPeriodButton;
+    CalendarHeatmap* pCalendarHeatmap;
+    wxStaticText* pTotalHoursLabel;
+    wxListCtrl* pWeekTotalsListCtrl;
+    wxListCtrl* pProjectTotalsListCtrl;
+    wxListCtrl* pCategoryTotalsListCtrl;
+
+    wxDateTime mPeriodStartDate;
+
+    enum { PeriodMonth = 0, PeriodYear };
+
+    enum {
+        IDC_PERIOD_CHOICE = wxID_HIGHEST + 1,
+        IDC_PREV_PERIOD,
+        IDC_PERIOD_LABEL,
+        IDC_NEXT_PERIOD,
+        IDC_HEATMAP,
+        IDC_TOTAL_HOURS,
+        IDC_WEEK_TOTALS,
+        IDC_PROJECT_TOTALS,
+        IDC_CATEGORY_TOTALS
+    };
+};
+} // namespace app::dlg
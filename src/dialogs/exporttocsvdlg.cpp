@@ -18,6 +18,9 @@
 
 #include "exporttocsvdlg.h"
 
+#include <algorithm>
+
+#include <sqlite_modern_cpp/errors.h>
 #include <wx/richtooltip.h>
 #include <wx/statline.h>
 #include <wx/stdpaths.h>
@@ -25,25 +28,98 @@
 
 #include "../common/common.h"
 #include "../common/resources.h"
+#include "../common/util.h"
 #include "../config/configurationprovider.h"
-#include "../services/csvexporter.h"
+#include "../services/exporter.h"
+
+wxDEFINE_EVENT(EXPORT_TO_CSV_THREAD_PROGRESS, wxThreadEvent);
+wxDEFINE_EVENT(EXPORT_TO_CSV_THREAD_COMPLETED, wxThreadEvent);
 
 namespace app::dlg
 {
+ExportToCsvThread::ExportToCsvThread(ExportToCsvDialog* handler,
+    std::shared_ptr<spdlog::logger> logger,
+    const svc::ExportOptions& options)
+    : wxThread(wxTHREAD_DETACHED)
+    , pHandler(handler)
+    , pLogger(logger)
+    , mOptions(options)
+{
+}
+
+ExportToCsvThread::~ExportToCsvThread()
+{
+    wxCriticalSectionLocker enter(pHandler->mCriticalSection);
+    pHandler->pThread = nullptr;
+}
+
+wxThread::ExitCode ExportToCsvThread::Entry()
+{
+    /* the exporter acquires its own connection from the pool for the lifetime of this thread */
+    auto exporter = svc::CreateExporter(pLogger, mOptions);
+
+    long long estimatedRowCount = 0;
+    try {
+        estimatedRowCount = exporter->EstimateRowCount();
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on IExporter::EstimateRowCount() - {0:d} : {1}", e.get_code(), e.what());
+    }
+
+    auto status = exporter->ExportData([&](long long rowsWritten) {
+        if (TestDestroy()) {
+            return false;
+        }
+
+        int percentage = 100;
+        if (estimatedRowCount > 0) {
+            percentage = static_cast<int>(std::min(100LL, rowsWritten * 100 / estimatedRowCount));
+        }
+
+        auto progressEvent = new wxThreadEvent(EXPORT_TO_CSV_THREAD_PROGRESS);
+        progressEvent->SetInt(percentage);
+        progressEvent->SetString(wxString::Format(wxT("Exported %lld of %lld rows"), rowsWritten, estimatedRowCount));
+        wxQueueEvent(pHandler, progressEvent);
+
+        return true;
+    });
+
+    auto event = new wxThreadEvent(EXPORT_TO_CSV_THREAD_COMPLETED);
+    event->SetInt(static_cast<int>(status));
+    wxQueueEvent(pHandler, event);
+
+    return (wxThread::ExitCode) 0;
+}
+
 ExportToCsvDialog::ExportToCsvDialog(wxWindow* parent, std::shared_ptr<spdlog::logger> logger, const wxString& name)
-    : pLogger(logger)
+    : pThread(nullptr)
+    , mCriticalSection()
+    , pLogger(logger)
     , pStartDateCtrl(nullptr)
     , pEndDateCtrl(nullptr)
+    , pDeltaCheckBox(nullptr)
+    , pFormatChoiceCtrl(nullptr)
     , pDelimiterTextCtrl(nullptr)
+    , pCompressCheckBox(nullptr)
+    , pPartitionCheckBox(nullptr)
+    , pCombinePartitionsCheckBox(nullptr)
     , pExportFilePathCtrl(nullptr)
     , pBrowseExportPathButton(nullptr)
     , pExportFileNameCtrl(nullptr)
     , pFeedbackLabel(nullptr)
+    , pProgressGauge(nullptr)
     , pExportButton(nullptr)
+    , pCancelExportButton(nullptr)
+    , pOkButton(nullptr)
+    , mExportPath(wxGetEmptyString())
 {
     Create(parent, wxID_ANY, "Export to CSV", wxDefaultPosition, wxDefaultSize, wxCAPTION | wxCLOSE_BOX, name);
 }
 
+ExportToCsvDialog::~ExportToCsvDialog()
+{
+    ThreadCleanupProcedure();
+}
+
 bool ExportToCsvDialog::Create(wxWindow* parent,
     wxWindowID windowId,
     const wxString& title,
@@ -123,6 +199,13 @@ void ExportToCsvDialog::CreateControls()
     pEndDateCtrl->SetToolTip("Set the end date range for the export");
     flexGridSizer->Add(pEndDateCtrl, common::sizers::ControlDefault);
 
+    /* Delta check box */
+    flexGridSizer->AddSpacer(0);
+
+    pDeltaCheckBox = new wxCheckBox(dateRangePanel, IDC_DELTA, "Only changes since last export");
+    pDeltaCheckBox->SetToolTip("Export task items added, modified or deleted since the last delta export");
+    flexGridSizer->Add(pDeltaCheckBox, common::sizers::ControlDefault);
+
     dateRangeStaticBoxSizer->AddSpacer(6);
 
     /* Options static box */
@@ -137,6 +220,17 @@ void ExportToCsvDialog::CreateControls()
     auto optionsFlexGridSizer = new wxFlexGridSizer(0, 2, 0, 0);
     optionsPanel->SetSizer(optionsFlexGridSizer);
 
+    /* Format choice control */
+    auto formatLabel = new wxStaticText(optionsPanel, wxID_ANY, "Format");
+    optionsFlexGridSizer->Add(formatLabel, common::sizers::ControlCenter);
+
+    pFormatChoiceCtrl = new wxChoice(optionsPanel, IDC_FORMAT);
+    pFormatChoiceCtrl->Append("CSV", util::IntToVoidPointer(static_cast<int>(svc::ExportFormat::Csv)));
+    pFormatChoiceCtrl->Append("JSON Lines", util::IntToVoidPointer(static_cast<int>(svc::ExportFormat::JsonLines)));
+    pFormatChoiceCtrl->SetSelection(0);
+    pFormatChoiceCtrl->SetToolTip("Set the format of the exported file");
+    optionsFlexGridSizer->Add(pFormatChoiceCtrl, common::sizers::ControlDefault);
+
     /* Delimiter text control */
     auto delimiterLabel = new wxStaticText(optionsPanel, wxID_ANY, "Delimiter");
     optionsFlexGridSizer->Add(delimiterLabel, common::sizers::ControlCenter);
@@ -147,6 +241,28 @@ void ExportToCsvDialog::CreateControls()
     pDelimiterTextCtrl->SetToolTip("Set the delimiter to use in the exported file");
     optionsFlexGridSizer->Add(pDelimiterTextCtrl, common::sizers::ControlDefault);
 
+    /* Compress check box */
+    optionsFlexGridSizer->AddSpacer(0);
+
+    pCompressCheckBox = new wxCheckBox(optionsPanel, IDC_COMPRESS, "Compress (.gz)");
+    pCompressCheckBox->SetToolTip("Compress the exported file with gzip");
+    optionsFlexGridSizer->Add(pCompressCheckBox, common::sizers::ControlDefault);
+
+    /* Partition check boxes */
+    optionsFlexGridSizer->AddSpacer(0);
+
+    pPartitionCheckBox = new wxCheckBox(optionsPanel, IDC_PARTITION, "Export months in parallel");
+    pPartitionCheckBox->SetToolTip("Split the date range into months and export them at the same time");
+    optionsFlexGridSizer->Add(pPartitionCheckBox, common::sizers::ControlDefault);
+
+    optionsFlexGridSizer->AddSpacer(0);
+
+    pCombinePartitionsCheckBox = new wxCheckBox(optionsPanel, IDC_COMBINEPARTITIONS, "Combine months into one file");
+    pCombinePartitionsCheckBox->SetToolTip("Join the months in date order instead of writing a file per month");
+    pCombinePartitionsCheckBox->SetValue(true);
+    pCombinePartitionsCheckBox->Disable();
+    optionsFlexGridSizer->Add(pCombinePartitionsCheckBox, common::sizers::ControlDefault);
+
     /* Right Sizer */
     /* File Options static box*/
     auto fileOptionsStaticBox = new wxStaticBox(this, wxID_ANY, "File Options");
@@ -191,6 +307,11 @@ void ExportToCsvDialog::CreateControls()
     pFeedbackLabel = new wxStaticText(this, IDC_FEEDBACK, wxGetEmptyString());
     rightSizer->Add(pFeedbackLabel, common::sizers::ControlCenterHorizontal);
 
+    /* Progress gauge */
+    pProgressGauge = new wxGauge(this, IDC_PROGRESS, 100, wxDefaultPosition, wxSize(256, -1), wxGA_HORIZONTAL);
+    pProgressGauge->SetToolTip("Shows the progress of the export");
+    rightSizer->Add(pProgressGauge, common::sizers::ControlCenterHorizontal);
+
     /* Bottom */
     /* Horizontal Line*/
     auto bottomSeparationLine = new wxStaticLine(this, wxID_ANY, wxDefaultPosition, wxSize(3, 3), wxLI_HORIZONTAL);
@@ -207,6 +328,10 @@ void ExportToCsvDialog::CreateControls()
     pExportButton = new wxButton(buttonPanel, IDC_EXPORTBUTTON, "Export");
     buttonPanelSizer->Add(pExportButton, common::sizers::ControlDefault);
 
+    pCancelExportButton = new wxButton(buttonPanel, IDC_CANCELEXPORTBUTTON, "Cancel Export");
+    pCancelExportButton->Disable();
+    buttonPanelSizer->Add(pCancelExportButton, common::sizers::ControlDefault);
+
     pOkButton = new wxButton(buttonPanel, wxID_OK, "OK");
     buttonPanelSizer->Add(pOkButton, wxSizerFlags().Border(wxALL, 5));
 }
@@ -232,6 +357,24 @@ void ExportToCsvDialog::ConfigureEventBindings()
         this
     );
 
+    pFormatChoiceCtrl->Bind(
+        wxEVT_CHOICE,
+        &ExportToCsvDialog::OnFormatChoice,
+        this
+    );
+
+    pDeltaCheckBox->Bind(
+        wxEVT_CHECKBOX,
+        &ExportToCsvDialog::OnDeltaCheck,
+        this
+    );
+
+    pPartitionCheckBox->Bind(
+        wxEVT_CHECKBOX,
+        &ExportToCsvDialog::OnPartitionCheck,
+        this
+    );
+
     pBrowseExportPathButton->Bind(
         wxEVT_BUTTON,
         &ExportToCsvDialog::OnOpenDirectoryForExportLocation,
@@ -245,6 +388,25 @@ void ExportToCsvDialog::ConfigureEventBindings()
         this,
         IDC_EXPORTBUTTON
     );
+
+    pCancelExportButton->Bind(
+        wxEVT_BUTTON,
+        &ExportToCsvDialog::OnCancelExport,
+        this,
+        IDC_CANCELEXPORTBUTTON
+    );
+
+    Bind(
+        EXPORT_TO_CSV_THREAD_PROGRESS,
+        &ExportToCsvDialog::OnThreadProgress,
+        this
+    );
+
+    Bind(
+        EXPORT_TO_CSV_THREAD_COMPLETED,
+        &ExportToCsvDialog::OnThreadCompletion,
+        this
+    );
 }
 // clang-format on
 
@@ -307,12 +469,14 @@ void ExportToCsvDialog::OnExport(wxCommandEvent& event)
     /* check if dates are correctly selected */
     auto start = pStartDateCtrl->GetValue();
     auto end = pEndDateCtrl->GetValue();
+    bool delta = pDeltaCheckBox->IsChecked();
 
-    if (start.IsLaterThan(end)) {
+    /* a delta export is not limited to a date range */
+    if (!delta && start.IsLaterThan(end)) {
         return;
     }
 
-    if (end.IsEarlierThan(start)) {
+    if (!delta && end.IsEarlierThan(start)) {
         return;
     }
 
@@ -330,37 +494,95 @@ void ExportToCsvDialog::OnExport(wxCommandEvent& event)
     }
 
     /* get the filename and validate or generate it */
+    auto format = static_cast<svc::ExportFormat>(
+        util::VoidPointerToInt(pFormatChoiceCtrl->GetClientData(pFormatChoiceCtrl->GetSelection())));
+    const wxString extension = format == svc::ExportFormat::JsonLines ? ".jsonl" : ".csv";
+
     auto fileName = pExportFileNameCtrl->GetValue();
-    if (fileName.empty()) {
-        fileName = "Taskable_Export_" + startDate + "_" + endDate + ".csv";
+    if (fileName.empty() && delta) {
+        fileName = "Taskable_Delta_" + wxDateTime::Now().Format("%Y-%m-%dT%H%M%S") + extension;
+    } else if (fileName.empty()) {
+        fileName = "Taskable_Export_" + startDate + "_" + endDate + extension;
     } else {
-        if (!fileName.Contains(".csv")) {
-            fileName += ".csv";
+        if (!fileName.Contains(extension)) {
+            fileName += extension;
         }
     }
 
-    wxBeginBusyCursor();
-
-    /* do the export and display the operation output */
-    svc::CsvExporter csvExporter(pLogger, startDate.ToStdString(), endDate.ToStdString(), fileName.ToStdString());
-    if (csvExporter.ExportData()) {
-        pFeedbackLabel->SetLabel("Success! Click 'OK' to close the dialog.");
-    } else {
-        wxString errorMessage = "Data export encountered an error!";
-        pFeedbackLabel->SetLabel(errorMessage);
+    bool compressed = pCompressCheckBox->IsChecked();
+    if (compressed && !fileName.EndsWith(".gz")) {
+        fileName += ".gz";
     }
 
-    wxEndBusyCursor();
+    /* resolve the export options here so the worker thread never touches the controls or the configuration */
+    auto delimiter = pDelimiterTextCtrl->GetValue();
+
+    svc::ExportOptions options;
+    options.Format = format;
+    options.FromDate = startDate.ToStdString();
+    options.ToDate = endDate.ToStdString();
+    options.FilePath = wxString::Format(wxT("%s\\%s"), exportPath, fileName).ToStdString();
+    options.Delimiter = delimiter.empty() ? ',' : static_cast<char>(delimiter[0]);
+    options.Columns = cfg::ConfigurationProvider::Get().Configuration->GetExportColumns();
+    options.Compressed = compressed;
+    options.CompressionLevel = cfg::ConfigurationProvider::Get().Configuration->GetCompressionLevel();
+    options.Delta = delta;
+    options.Partitioned = !delta && pPartitionCheckBox->IsChecked();
+    options.CombinePartitions = pCombinePartitionsCheckBox->IsChecked();
+
+    mExportPath = exportPath;
+
+    pFeedbackLabel->SetLabel("Exporting...");
+    pProgressGauge->SetValue(0);
+    pExportButton->Disable();
+    pOkButton->Disable();
+    pCancelExportButton->Enable();
+
+    StartThread(options);
+
+    GetSizer()->Layout();
+}
 
-    // TODO: Wrap this if Windows is defined
+void ExportToCsvDialog::OnCancelExport(wxCommandEvent& event)
+{
     {
-        /* open file explorer */
-        ShellExecute(nullptr, wxT("open"), exportPath.c_str(), nullptr, nullptr, SW_SHOWDEFAULT);
+        wxCriticalSectionLocker enter(mCriticalSection);
+        if (pThread) {
+            auto ret = pThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                wxLogError("Cannot delete thread!");
+            }
+        }
     }
 
+    pCancelExportButton->Disable();
+    pFeedbackLabel->SetLabel("Cancelling export...");
     GetSizer()->Layout();
 }
 
+void ExportToCsvDialog::OnFormatChoice(wxCommandEvent& event)
+{
+    auto format = static_cast<svc::ExportFormat>(util::VoidPointerToInt(event.GetClientData()));
+
+    pDelimiterTextCtrl->Enable(format == svc::ExportFormat::Csv);
+    pExportFileNameCtrl->SetHint(format == svc::ExportFormat::JsonLines ? "Exported Data.jsonl" : "Exported Data.csv");
+}
+
+void ExportToCsvDialog::OnDeltaCheck(wxCommandEvent& event)
+{
+    pStartDateCtrl->Enable(!event.IsChecked());
+    pEndDateCtrl->Enable(!event.IsChecked());
+
+    /* a delta has no date range to split into months */
+    pPartitionCheckBox->Enable(!event.IsChecked());
+    pCombinePartitionsCheckBox->Enable(!event.IsChecked() && pPartitionCheckBox->IsChecked());
+}
+
+void ExportToCsvDialog::OnPartitionCheck(wxCommandEvent& event)
+{
+    pCombinePartitionsCheckBox->Enable(event.IsChecked());
+}
+
 void ExportToCsvDialog::OnDelimiterChange(wxCommandEvent& event)
 {
     auto text = event.GetString();
@@ -370,6 +592,45 @@ void ExportToCsvDialog::OnDelimiterChange(wxCommandEvent& event)
     }
 }
 
+void ExportToCsvDialog::OnThreadProgress(wxThreadEvent& event)
+{
+    pProgressGauge->SetValue(event.GetInt());
+    pFeedbackLabel->SetLabel(event.GetString());
+    GetSizer()->Layout();
+}
+
+void ExportToCsvDialog::OnThreadCompletion(wxThreadEvent& event)
+{
+    pExportButton->Enable();
+    pOkButton->Enable();
+    pCancelExportButton->Disable();
+
+    auto status = static_cast<svc::ExportStatus>(event.GetInt());
+    switch (status) {
+    case svc::ExportStatus::Completed:
+        pProgressGauge->SetValue(100);
+        pFeedbackLabel->SetLabel("Success! Click 'OK' to close the dialog.");
+
+        // TODO: Wrap this if Windows is defined
+        {
+            /* open file explorer */
+            ShellExecute(nullptr, wxT("open"), mExportPath.c_str(), nullptr, nullptr, SW_SHOWDEFAULT);
+        }
+        break;
+    case svc::ExportStatus::Cancelled:
+        pProgressGauge->SetValue(0);
+        pFeedbackLabel->SetLabel("Export cancelled, the partial file was removed.");
+        break;
+    case svc::ExportStatus::Failed:
+    default:
+        pProgressGauge->SetValue(0);
+        pFeedbackLabel->SetLabel("Data export encountered an error!");
+        break;
+    }
+
+    GetSizer()->Layout();
+}
+
 void ExportToCsvDialog::DateValidationProcedure()
 {
     auto startDate = pStartDateCtrl->GetValue();
@@ -387,4 +648,43 @@ void ExportToCsvDialog::DateValidationProcedure()
         tooltip.ShowFor(pEndDateCtrl);
     }
 }
+
+void ExportToCsvDialog::StartThread(const svc::ExportOptions& options)
+{
+    pThread = new ExportToCsvThread(this, pLogger, options);
+    auto ret = pThread->Run();
+    if (ret != wxTHREAD_NO_ERROR) {
+        delete pThread;
+        pThread = nullptr;
+
+        pLogger->error("Failed to start the export thread");
+        pExportButton->Enable();
+        pOkButton->Enable();
+        pCancelExportButton->Disable();
+        pFeedbackLabel->SetLabel("Data export encountered an error!");
+    }
+}
+
+void ExportToCsvDialog::ThreadCleanupProcedure()
+{
+    {
+        wxCriticalSectionLocker enter(mCriticalSection);
+        if (pThread) {
+            auto ret = pThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                wxLogError("Cannot delete thread!");
+            }
+        }
+    }
+
+    while (1) {
+        {
+            wxCriticalSectionLocker enter(mCriticalSection);
+            if (!pThread) {
+                break;
+            }
+        }
+        wxThread::This()->Sleep(1);
+    }
+}
 } // namespace app::dlg
@@ -21,16 +21,46 @@
 #include <spdlog/spdlog.h>
 #include <wx/wx.h>
 #include <wx/datectrl.h>
+#include <wx/thread.h>
+
+#include "../services/exportoptions.h"
+
+wxDECLARE_EVENT(EXPORT_TO_CSV_THREAD_PROGRESS, wxThreadEvent);
+wxDECLARE_EVENT(EXPORT_TO_CSV_THREAD_COMPLETED, wxThreadEvent);
 
 namespace app::dlg
 {
+class ExportToCsvDialog;
+
+class ExportToCsvThread final : public wxThread
+{
+public:
+    ExportToCsvThread() = delete;
+    ExportToCsvThread(ExportToCsvDialog* handler,
+        std::shared_ptr<spdlog::logger> logger,
+        const svc::ExportOptions& options);
+    virtual ~ExportToCsvThread();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    ExportToCsvDialog* pHandler;
+    std::shared_ptr<spdlog::logger> pLogger;
+    svc::ExportOptions mOptions;
+};
+
 class ExportToCsvDialog final : public wxDialog
 {
 public:
     ExportToCsvDialog(wxWindow* parent,
         std::shared_ptr<spdlog::logger> logger,
         const wxString& name = "exporttocsvdlg");
-    virtual ~ExportToCsvDialog() = default;
+    virtual ~ExportToCsvDialog();
+
+protected:
+    ExportToCsvThread* pThread;
+    wxCriticalSection mCriticalSection;
 
 private:
     bool Create(wxWindow* parent,
@@ -49,31 +79,58 @@ class ExportToCsvDialog final : public wxDialog
     void OnEndDateFocusLost(wxFocusEvent& event);
     void OnOpenDirectoryForExportLocation(wxCommandEvent& event);
     void OnExport(wxCommandEvent& event);
+    void OnCancelExport(wxCommandEvent& event);
     void OnDelimiterChange(wxCommandEvent& event);
+    void OnFormatChoice(wxCommandEvent& event);
+    void OnDeltaCheck(wxCommandEvent& event);
+    void OnPartitionCheck(wxCommandEvent& event);
+    void OnThreadProgress(wxThreadEvent& event);
+    void OnThreadCompletion(wxThreadEvent& event);
 
     void DateValidationProcedure();
 
+    void StartThread(const svc::ExportOptions& options);
+    void ThreadCleanupProcedure();
+
+    friend class ExportToCsvThread;
+
     std::shared_ptr<spdlog::logger> pLogger;
 
     wxDatePickerCtrl* pStartDateCtrl;
     wxDatePickerCtrl* pEndDateCtrl;
+    wxCheckBox* pDeltaCheckBox;
+    wxChoice* pFormatChoiceCtrl;
     wxTextCtrl* pDelimiterTextCtrl;
+    wxCheckBox* pCompressCheckBox;
+    wxCheckBox* pPartitionCheckBox;
+    wxCheckBox* pCombinePartitionsCheckBox;
     wxTextCtrl* pExportFilePathCtrl;
     wxButton* pBrowseExportPathButton;
     wxTextCtrl* pExportFileNameCtrl;
     wxStaticText* pFeedbackLabel;
+    wxGauge* pProgressGauge;
     wxButton* pExportButton;
+    wxButton* pCancelExportButton;
     wxButton* pOkButton;
 
+    wxString mExportPath;
+
     enum {
         IDC_STARTDATE = wxID_HIGHEST + 1,
         IDC_ENDDATE,
+        IDC_DELTA,
+        IDC_FORMAT,
         IDC_DELIMITER,
+        IDC_COMPRESS,
+        IDC_PARTITION,
+        IDC_COMBINEPARTITIONS,
         IDC_EXPORTPATH,
         IDC_EXPORTPATHBUTTON,
         IDC_EXPORTFILE,
         IDC_FEEDBACK,
-        IDC_EXPORTBUTTON
+        IDC_PROGRESS,
+        IDC_EXPORTBUTTON,
+        IDC_CANCELEXPORTBUTTON
     };
 };
 } // namespace app::dlg
@@ -34,9 +34,16 @@ DatabasePage::DatabasePage(wxWindow* parent, cfg::Configuration* config)
     , pDatabasePathTextCtrl(nullptr)
     , pBrowseDatabasePathButton(nullptr)
     , pBackupDatabaseCtrl(nullptr)
+    , pCompressBackupsCtrl(nullptr)
+    , pIncrementalBackupsCtrl(nullptr)
     , pBackupPathTextCtrl(nullptr)
     , pBrowseBackupPathButton(nullptr)
     , pDeleteBackupsAfterCtrl(nullptr)
+    , pBackupIntervalCtrl(nullptr)
+    , pKeepDailyBackupsCtrl(nullptr)
+    , pKeepWeeklyBackupsCtrl(nullptr)
+    , pKeepMonthlyBackupsCtrl(nullptr)
+    , pIntegrityCheckIntervalCtrl(nullptr)
 {
     CreateControls();
     ConfigureEventBindings();
@@ -47,8 +54,15 @@ void DatabasePage::Apply()
 {
     pConfig->SetDatabasePath(pDatabasePathTextCtrl->GetValue().ToStdString());
     pConfig->SetBackupEnabled(pBackupDatabaseCtrl->GetValue());
+    pConfig->SetCompressBackups(pCompressBackupsCtrl->GetValue());
+    pConfig->SetIncrementalBackups(pIncrementalBackupsCtrl->GetValue());
     pConfig->SetBackupPath(pBackupPathTextCtrl->GetValue().ToStdString());
     pConfig->SetDeleteBackupsAfter(std::stoi(pDeleteBackupsAfterCtrl->GetValue().ToStdString()));
+    pConfig->SetBackupInterval(std::stoi(pBackupIntervalCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepDailyBackups(std::stoi(pKeepDailyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepWeeklyBackups(std::stoi(pKeepWeeklyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepMonthlyBackups(std::stoi(pKeepMonthlyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetIntegrityCheckInterval(std::stoi(pIntegrityCheckIntervalCtrl->GetValue().ToStdString()));
 }
 
 void DatabasePage::CreateControls()
@@ -88,6 +102,16 @@ void DatabasePage::CreateControls()
     pBackupDatabaseCtrl = new wxCheckBox(backupsSettingsBox, IDC_BACKUP_DATABASE, wxT("Backup Database"));
     backupsSizer->Add(pBackupDatabaseCtrl, common::sizers::ControlDefault);
 
+    pCompressBackupsCtrl = new wxCheckBox(backupsSettingsBox, IDC_COMPRESS_BACKUPS, wxT("Compress Backups (.gz)"));
+    pCompressBackupsCtrl->SetToolTip(wxT("Store backups as gzip archives, which take several times less space"));
+    backupsSizer->Add(pCompressBackupsCtrl, common::sizers::ControlDefault);
+
+    pIncrementalBackupsCtrl =
+        new wxCheckBox(backupsSettingsBox, IDC_INCREMENTAL_BACKUPS, wxT("Incremental Backups (deduplicated)"));
+    pIncrementalBackupsCtrl->SetToolTip(
+        wxT("Store only the parts of the database that changed since earlier backups (overrides compression)"));
+    backupsSizer->Add(pIncrementalBackupsCtrl, common::sizers::ControlDefault);
+
     auto gridSizer = new wxBoxSizer(wxHORIZONTAL);
     backupsSizer->Add(gridSizer, common::sizers::ControlDefault);
 
@@ -128,8 +152,95 @@ void DatabasePage::CreateControls()
     pDeleteBackupsAfterCtrl->SetToolTip(wxT("Number of days to keep a database backup"));
     backupOptionsSizer->Add(pDeleteBackupsAfterCtrl, common::sizers::ControlDefault);
 
+    auto backupIntervalLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Back Up Every (minutes)"));
+    backupOptionsSizer->Add(backupIntervalLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> intervalValidator;
+    intervalValidator.SetMin(5);
+    intervalValidator.SetMax(1440);
+
+    pBackupIntervalCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_BACKUP_INTERVAL,
+        wxT("60"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        intervalValidator);
+    pBackupIntervalCtrl->SetToolTip(wxT("Minutes between backups, taken once the computer has been idle for a while"));
+    backupOptionsSizer->Add(pBackupIntervalCtrl, common::sizers::ControlDefault);
+
+    auto integrityCheckIntervalLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Full Check Every (days)"));
+    backupOptionsSizer->Add(integrityCheckIntervalLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> integrityCheckValidator;
+    integrityCheckValidator.SetMin(0);
+    integrityCheckValidator.SetMax(365);
+
+    pIntegrityCheckIntervalCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_INTEGRITY_CHECK_INTERVAL,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        integrityCheckValidator);
+    pIntegrityCheckIntervalCtrl->SetToolTip(
+        wxT("Days between full integrity checks of a new backup, 0 only runs the quick check after each backup"));
+    backupOptionsSizer->Add(pIntegrityCheckIntervalCtrl, common::sizers::ControlDefault);
+
     sizer->Add(databaseBackupsSizer, 0, wxLEFT | wxRIGHT | wxEXPAND, 5);
 
+    /* Backup Retention Panel */
+    auto backupRetentionBox = new wxStaticBox(this, wxID_ANY, wxT("Backup Retention (0 everywhere deletes by age)"));
+    auto backupRetentionSizer = new wxStaticBoxSizer(backupRetentionBox, wxHORIZONTAL);
+
+    auto retentionOptionsSizer = new wxBoxSizer(wxHORIZONTAL);
+    backupRetentionSizer->Add(retentionOptionsSizer, 1, wxALL | wxEXPAND, 5);
+
+    wxIntegerValidator<int> retentionValidator;
+    retentionValidator.SetMin(0);
+    retentionValidator.SetMax(365);
+
+    auto keepDailyBackupsLabel = new wxStaticText(backupRetentionBox, wxID_ANY, wxT("Keep Daily"));
+    retentionOptionsSizer->Add(keepDailyBackupsLabel, common::sizers::ControlCenter);
+
+    pKeepDailyBackupsCtrl = new wxTextCtrl(backupRetentionBox,
+        IDC_KEEP_DAILY_BACKUPS,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        retentionValidator);
+    pKeepDailyBackupsCtrl->SetToolTip(wxT("Number of days to keep the newest backup of"));
+    retentionOptionsSizer->Add(pKeepDailyBackupsCtrl, common::sizers::ControlDefault);
+
+    auto keepWeeklyBackupsLabel = new wxStaticText(backupRetentionBox, wxID_ANY, wxT("Weekly"));
+    retentionOptionsSizer->Add(keepWeeklyBackupsLabel, common::sizers::ControlCenter);
+
+    pKeepWeeklyBackupsCtrl = new wxTextCtrl(backupRetentionBox,
+        IDC_KEEP_WEEKLY_BACKUPS,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        retentionValidator);
+    pKeepWeeklyBackupsCtrl->SetToolTip(wxT("Number of weeks to keep the newest backup of"));
+    retentionOptionsSizer->Add(pKeepWeeklyBackupsCtrl, common::sizers::ControlDefault);
+
+    auto keepMonthlyBackupsLabel = new wxStaticText(backupRetentionBox, wxID_ANY, wxT("Monthly"));
+    retentionOptionsSizer->Add(keepMonthlyBackupsLabel, common::sizers::ControlCenter);
+
+    pKeepMonthlyBackupsCtrl = new wxTextCtrl(backupRetentionBox,
+        IDC_KEEP_MONTHLY_BACKUPS,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        retentionValidator);
+    pKeepMonthlyBackupsCtrl->SetToolTip(wxT("Number of months to keep the newest backup of"));
+    retentionOptionsSizer->Add(pKeepMonthlyBackupsCtrl, common::sizers::ControlDefault);
+
+    sizer->Add(backupRetentionSizer, 0, wxLEFT | wxRIGHT | wxEXPAND, 5);
+
     SetSizerAndFit(sizer);
 }
 
@@ -148,13 +259,27 @@ void DatabasePage::FillControls()
 {
     pDatabasePathTextCtrl->SetValue(pConfig->GetDatabasePath());
     pBackupDatabaseCtrl->SetValue(pConfig->IsBackupEnabled());
+    pCompressBackupsCtrl->SetValue(pConfig->IsCompressBackups());
+    pIncrementalBackupsCtrl->SetValue(pConfig->IsIncrementalBackups());
     pBackupPathTextCtrl->SetValue(pConfig->GetBackupPath());
     pDeleteBackupsAfterCtrl->SetValue(wxString(std::to_string(pConfig->GetDeleteBackupsAfter())));
+    pBackupIntervalCtrl->SetValue(wxString(std::to_string(pConfig->GetBackupInterval())));
+    pKeepDailyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepDailyBackups())));
+    pKeepWeeklyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepWeeklyBackups())));
+    pKeepMonthlyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepMonthlyBackups())));
+    pIntegrityCheckIntervalCtrl->SetValue(wxString(std::to_string(pConfig->GetIntegrityCheckInterval())));
 
     if (!pBackupDatabaseCtrl->GetValue()) {
+        pCompressBackupsCtrl->Disable();
+        pIncrementalBackupsCtrl->Disable();
         pBackupPathTextCtrl->Disable();
         pBrowseBackupPathButton->Disable();
         pDeleteBackupsAfterCtrl->Disable();
+        pBackupIntervalCtrl->Disable();
+        pKeepDailyBackupsCtrl->Disable();
+        pKeepWeeklyBackupsCtrl->Disable();
+        pKeepMonthlyBackupsCtrl->Disable();
+        pIntegrityCheckIntervalCtrl->Disable();
     }
 }
 
@@ -183,13 +308,27 @@ void DatabasePage::OnOpenDirectoryForDatabaseLocation(wxCommandEvent& event)
 void DatabasePage::OnBackupDatabaseCheck(wxCommandEvent& event)
 {
     if (event.IsChecked()) {
+        pCompressBackupsCtrl->Enable();
+        pIncrementalBackupsCtrl->Enable();
         pBackupPathTextCtrl->Enable();
         pBrowseBackupPathButton->Enable();
         pDeleteBackupsAfterCtrl->Enable();
+        pBackupIntervalCtrl->Enable();
+        pKeepDailyBackupsCtrl->Enable();
+        pKeepWeeklyBackupsCtrl->Enable();
+        pKeepMonthlyBackupsCtrl->Enable();
+        pIntegrityCheckIntervalCtrl->Enable();
     } else {
+        pCompressBackupsCtrl->Disable();
+        pIncrementalBackupsCtrl->Disable();
         pBackupPathTextCtrl->Disable();
         pBrowseBackupPathButton->Disable();
         pDeleteBackupsAfterCtrl->Disable();
+        pBackupIntervalCtrl->Disable();
+        pKeepDailyBackupsCtrl->Disable();
+        pKeepWeeklyBackupsCtrl->Disable();
+        pKeepMonthlyBackupsCtrl->Disable();
+        pIntegrityCheckIntervalCtrl->Disable();
     }
 }
 
@@ -55,17 +55,31 @@ class DatabasePage final : public wxPanel
     wxTextCtrl* pDatabasePathTextCtrl;
     wxButton* pBrowseDatabasePathButton;
     wxCheckBox* pBackupDatabaseCtrl;
+    wxCheckBox* pCompressBackupsCtrl;
+    wxCheckBox* pIncrementalBackupsCtrl;
     wxTextCtrl* pBackupPathTextCtrl;
     wxButton* pBrowseBackupPathButton;
     wxTextCtrl* pDeleteBackupsAfterCtrl;
+    wxTextCtrl* pBackupIntervalCtrl;
+    wxTextCtrl* pKeepDailyBackupsCtrl;
+    wxTextCtrl* pKeepWeeklyBackupsCtrl;
+    wxTextCtrl* pKeepMonthlyBackupsCtrl;
+    wxTextCtrl* pIntegrityCheckIntervalCtrl;
 
     enum {
         IDC_DATABASE_PATH = wxID_HIGHEST + 1,
         IDC_DATABASE_PATH_BUTTON,
         IDC_BACKUP_DATABASE,
+        IDC_COMPRESS_BACKUPS,
+        IDC_INCREMENTAL_BACKUPS,
         IDC_BACKUP_PATH,
         IDC_BACKUP_PATH_BUTTON,
-        IDC_DELETE_BACKUPS_AFTER
+        IDC_DELETE_BACKUPS_AFTER,
+        IDC_BACKUP_INTERVAL,
+        IDC_KEEP_DAILY_BACKUPS,
+        IDC_KEEP_WEEKLY_BACKUPS,
+        IDC_KEEP_MONTHLY_BACKUPS,
+        IDC_INTEGRITY_CHECK_INTERVAL
     };
 };
 } // namespace app::dlg
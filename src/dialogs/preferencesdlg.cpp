@@ -40,6 +40,7 @@ PreferencesDialog::PreferencesDialog(wxWindow* parent,
     const wxString& name)
     : pLogger(logger)
     , pTaskBarIcon(taskBarIcon)
+    , pConfig(nullptr)
     , pParent(parent)
     , pGeneralPage(nullptr)
     , pDatabasePage(nullptr)
@@ -79,7 +80,8 @@ void PreferencesDialog::CreateControls()
 {
     auto listBook = static_cast<wxListbook*>(GetBookCtrl());
 
-    auto* config = cfg::ConfigurationProvider::Get().Configuration.get();
+    pConfig = std::make_unique<cfg::Configuration>(cfg::ConfigurationProvider::Get().Configuration->GetSnapshot());
+    auto* config = pConfig.get();
 
     pGeneralPage = new GeneralPage(listBook, config);
     pDatabasePage = new DatabasePage(listBook, config);
@@ -110,39 +112,18 @@ void PreferencesDialog::OnOk(wxCommandEvent& event)
     pTaskItemPage->Apply();
     pExportPage->Apply();
 
-    if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled() &&
-        cfg::ConfigurationProvider::Get().Configuration->GetBackupPath().length() == 0) {
-        wxMessageBox("A backup path must be selected.", common::GetProgramName(), wxOK_DEFAULT | wxICON_WARNING);
-        return;
-    }
-
-    if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled() &&
-        cfg::ConfigurationProvider::Get().Configuration->GetDeleteBackupsAfter() <= 0) {
-        wxMessageBox("A positive non-zero value is required if backups are enabled",
-            common::GetProgramName(),
-            wxOK_DEFAULT | wxICON_WARNING);
-        return;
-    }
-
-    if (cfg::ConfigurationProvider::Get().Configuration->GetExportPath().length() == 0) {
-        wxMessageBox("A export path must be selected",
-            common::GetProgramName(),
-            wxOK_DEFAULT | wxICON_WARNING);
-        return;
-    }
-
-    if (cfg::ConfigurationProvider::Get().Configuration->GetDelimiter().length() == 0) {
-        wxMessageBox("A delimiter is required",
-            common::GetProgramName(),
-            wxOK_DEFAULT | wxICON_WARNING);
+    auto error = cfg::Configuration::Validate(*pConfig->GetSnapshot());
+    if (!error.empty()) {
+        wxMessageBox(error, common::GetProgramName(), wxOK_DEFAULT | wxICON_WARNING);
         return;
     }
 
+    cfg::ConfigurationProvider::Get().Configuration->Publish(*pConfig->GetSnapshot());
     cfg::ConfigurationProvider::Get().Configuration->Save();
 
-    if (cfg::ConfigurationProvider::Get().Configuration->IsShowInTray() && !pTaskBarIcon->IsIconInstalled()) {
+    if (pConfig->IsShowInTray() && !pTaskBarIcon->IsIconInstalled()) {
         pTaskBarIcon->SetTaskBarIcon();
-    } else if (!cfg::ConfigurationProvider::Get().Configuration->IsShowInTray() && pTaskBarIcon->IsIconInstalled()) {
+    } else if (!pConfig->IsShowInTray() && pTaskBarIcon->IsIconInstalled()) {
         pTaskBarIcon->RemoveIcon();
     }
 
@@ -26,23 +26,18 @@
 #include <wx/wx.h>
 #include <wx/propdlg.h>
 
+#include "../config/configuration.h"
+
 #include "preferencesgeneralpage.h"
 #include "preferencesdatabasepage.h"
 #include "preferencesstopwatchpage.h"
 #include "preferencestaskitempage.h"
 #include "preferencesexportpage.h"
 
-namespace app
-{
-namespace cfg
-{
-class Configuration;
-}
-namespace frm
+namespace app::frm
 {
 class TaskBarIcon;
-}
-} // namespace app
+} // namespace app::frm
 
 namespace app::dlg
 {
@@ -73,6 +68,8 @@ class PreferencesDialog final : public wxPropertySheetDialog
 
     std::shared_ptr<spdlog::logger> pLogger;
     frm::TaskBarIcon* pTaskBarIcon;
+    /* the pages edit a detached copy which is published in one go once it validates */
+    std::unique_ptr<cfg::Configuration> pConfig;
 
     wxWindow* pParent;
     GeneralPage* pGeneralPage;
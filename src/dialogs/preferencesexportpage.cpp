@@ -31,6 +31,7 @@ ExportPage::ExportPage(wxWindow* parent, cfg::Configuration* config)
     , pConfig(config)
     , pParent(parent)
     , pDelimiterTextCtrl(nullptr)
+    , pCompressionLevelSpinCtrl(nullptr)
     , pExportFilePathCtrl(nullptr)
     , pBrowseExportPathButton(nullptr)
 {
@@ -42,6 +43,7 @@ ExportPage::ExportPage(wxWindow* parent, cfg::Configuration* config)
 void ExportPage::Apply()
 {
     pConfig->SetDelimiter(pDelimiterTextCtrl->GetValue().ToStdString());
+    pConfig->SetCompressionLevel(pCompressionLevelSpinCtrl->GetValue());
     pConfig->SetExportPath(pExportFilePathCtrl->GetValue().ToStdString());
 }
 
@@ -93,6 +95,21 @@ void ExportPage::CreateControls()
     pDelimiterTextCtrl->SetToolTip("Set the delimiter to use in the exported file");
     optionsFlexGridSizer->Add(pDelimiterTextCtrl, common::sizers::ControlDefault);
 
+    /* Compression level spin control */
+    auto compressionLevelLabel = new wxStaticText(optionsPanel, wxID_ANY, "Compression Level");
+    optionsFlexGridSizer->Add(compressionLevelLabel, common::sizers::ControlCenter);
+
+    pCompressionLevelSpinCtrl = new wxSpinCtrl(optionsPanel,
+        IDC_COMPRESSIONLEVEL,
+        wxEmptyString,
+        wxDefaultPosition,
+        wxDefaultSize,
+        wxSP_ARROW_KEYS | wxALIGN_CENTRE_HORIZONTAL,
+        0,
+        9);
+    pCompressionLevelSpinCtrl->SetToolTip("Set the gzip compression level for compressed exports (0 = none, 9 = smallest)");
+    optionsFlexGridSizer->Add(pCompressionLevelSpinCtrl, common::sizers::ControlDefault);
+
     sizer->Add(optionsStaticBoxSizer, 0, wxLEFT | wxRIGHT | wxEXPAND, 5);
 
     SetSizerAndFit(sizer);
@@ -113,6 +130,7 @@ void ExportPage::ConfigureEventBindings()
 void ExportPage::FillControls()
 {
     pDelimiterTextCtrl->SetValue(wxString(pConfig->GetDelimiter()));
+    pCompressionLevelSpinCtrl->SetValue(pConfig->GetCompressionLevel());
     pExportFilePathCtrl->SetValue(wxString(pConfig->GetExportPath()));
 }
 
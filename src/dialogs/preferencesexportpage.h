@@ -20,6 +20,7 @@
 #pragma once
 
 #include <wx/wx.h>
+#include <wx/spinctrl.h>
 
 namespace app::cfg
 {
@@ -49,11 +50,13 @@ class ExportPage final : public wxPanel
     wxWindow* pParent;
 
     wxTextCtrl* pDelimiterTextCtrl;
+    wxSpinCtrl* pCompressionLevelSpinCtrl;
     wxTextCtrl* pExportFilePathCtrl;
     wxButton* pBrowseExportPathButton;
 
     enum {
         IDC_DELIMITER = wxID_HIGHEST + 1,
+        IDC_COMPRESSIONLEVEL,
         IDC_EXPORTPATH,
         IDC_EXPORTPATHBUTTON,
     };
@@ -37,15 +37,103 @@
 
 #include "../data/taskdata.h"
 
-wxDEFINE_EVENT(EVT_TASK_ITEM_INSERTED, wxCommandEvent);
-wxDEFINE_EVENT(EVT_TASK_ITEM_UPDATED, wxCommandEvent);
-wxDEFINE_EVENT(EVT_TASK_ITEM_DELETED, wxCommandEvent);
+wxDEFINE_EVENT(EVT_TASK_ITEM_INSERTED, app::dlg::TaskItemEvent);
+wxDEFINE_EVENT(EVT_TASK_ITEM_UPDATED, app::dlg::TaskItemEvent);
+wxDEFINE_EVENT(EVT_TASK_ITEM_DELETED, app::dlg::TaskItemEvent);
 
 namespace app::dlg
 {
 static const wxString TaskContextWithoutClient = wxT("Employer %s");
 static const wxString TaskContextWithClient = wxT("Employer %s | Client %s");
 
+TaskItemEvent::TaskItemEvent(wxEventType eventType, int taskItemId)
+    : wxCommandEvent(eventType, taskItemId)
+    , mTaskItemId(taskItemId)
+    , mTaskDate(wxGetEmptyString())
+    , mProjectName(wxGetEmptyString())
+    , mDuration()
+    , mCategoryName(wxGetEmptyString())
+    , mCategoryColor()
+    , mDescription(wxGetEmptyString())
+{
+}
+
+wxEvent* TaskItemEvent::Clone() const
+{
+    return new TaskItemEvent(*this);
+}
+
+int TaskItemEvent::GetTaskItemId() const
+{
+    return mTaskItemId;
+}
+
+wxString TaskItemEvent::GetTaskDate() const
+{
+    return mTaskDate;
+}
+
+wxString TaskItemEvent::GetProjectName() const
+{
+    return mProjectName;
+}
+
+common::Duration TaskItemEvent::GetDuration() const
+{
+    return mDuration;
+}
+
+wxString TaskItemEvent::GetCategoryName() const
+{
+    return mCategoryName;
+}
+
+wxColor TaskItemEvent::GetCategoryColor() const
+{
+    return mCategoryColor;
+}
+
+wxString TaskItemEvent::GetDescription() const
+{
+    return mDescription;
+}
+
+void TaskItemEvent::SetTaskItemId(int taskItemId)
+{
+    mTaskItemId = taskItemId;
+    SetId(taskItemId);
+}
+
+void TaskItemEvent::SetTaskDate(const wxString& taskDate)
+{
+    mTaskDate = taskDate;
+}
+
+void TaskItemEvent::SetProjectName(const wxString& projectName)
+{
+    mProjectName = projectName;
+}
+
+void TaskItemEvent::SetDuration(common::Duration duration)
+{
+    mDuration = duration;
+}
+
+void TaskItemEvent::SetCategoryName(const wxString& categoryName)
+{
+    mCategoryName = categoryName;
+}
+
+void TaskItemEvent::SetCategoryColor(const wxColor& categoryColor)
+{
+    mCategoryColor = categoryColor;
+}
+
+void TaskItemEvent::SetDescription(const wxString& description)
+{
+    mDescription = description;
+}
+
 TaskItemDialog::TaskItemDialog(wxWindow* parent,
     std::shared_ptr<spdlog::logger> logger,
     constants::TaskItemTypes taskItemType,
@@ -594,15 +682,13 @@ void TaskItemDialog::DataToControls()
         pStartTimeCtrl->SetValue(*taskItem->GetStartTime());
         pEndTimeCtrl->SetValue(*taskItem->GetEndTime());
 
-        pDurationCtrl->SetLabel(taskItem->GetDuration());
+        pDurationCtrl->SetLabel(taskItem->GetDuration().ToString());
     }
     if (mType == constants::TaskItemTypes::EntryTask) {
-        auto durationTime = *taskItem->GetDurationTime();
+        auto duration = taskItem->GetDuration();
 
-        auto hours = durationTime.GetHour();
-        auto minutes = durationTime.GetMinute();
-        pDurationHoursCtrl->SetValue(hours);
-        pDurationMinutesCtrl->SetValue(minutes);
+        pDurationHoursCtrl->SetValue(duration.GetHours());
+        pDurationMinutesCtrl->SetValue(duration.GetMinutes());
     }
 
     FillCategoryControl(taskItem->GetProjectId());
@@ -626,25 +712,35 @@ void TaskItemDialog::CalculateTimeDiff(wxDateTime start, wxDateTime end)
     pDurationCtrl->SetLabelText(formated);
 }
 
-void TaskItemDialog::GenerateTaskInsertedEvent(int taskItemId)
+TaskItemEvent TaskItemDialog::CreateTaskItemEvent()
+{
+    TaskItemEvent taskItemEvent(wxEVT_NULL, mTaskItemId);
+    taskItemEvent.SetTaskDate(pDateContextCtrl->GetValue().FormatISODate());
+    taskItemEvent.SetProjectName(pTaskItem->GetProject()->GetDisplayName());
+    taskItemEvent.SetDuration(pTaskItem->GetDuration());
+    taskItemEvent.SetCategoryName(pCategoryChoiceCtrl->GetStringSelection());
+    taskItemEvent.SetCategoryColor(mCategoryColors[pTaskItem->GetCategoryId()]);
+    taskItemEvent.SetDescription(pTaskItem->GetDescription());
+
+    return taskItemEvent;
+}
+
+void TaskItemDialog::GenerateTaskInsertedEvent(TaskItemEvent& event)
 {
-    wxCommandEvent taskInsertedEvent(EVT_TASK_ITEM_INSERTED);
-    taskInsertedEvent.SetId(taskItemId);
-    wxPostEvent(pParent, taskInsertedEvent);
+    event.SetEventType(EVT_TASK_ITEM_INSERTED);
+    wxPostEvent(pParent, event);
 }
 
-void TaskItemDialog::GenerateTaskUpdatedEvent(int taskItemId)
+void TaskItemDialog::GenerateTaskUpdatedEvent(TaskItemEvent& event)
 {
-    wxCommandEvent taskInsertedEvent(EVT_TASK_ITEM_UPDATED);
-    taskInsertedEvent.SetId(taskItemId);
-    wxPostEvent(pParent, taskInsertedEvent);
+    event.SetEventType(EVT_TASK_ITEM_UPDATED);
+    wxPostEvent(pParent, event);
 }
 
-void TaskItemDialog::GenerateTaskDeletedEvent(int taskItemId)
+void TaskItemDialog::GenerateTaskDeletedEvent(TaskItemEvent& event)
 {
-    wxCommandEvent taskInsertedEvent(EVT_TASK_ITEM_DELETED);
-    taskInsertedEvent.SetId(taskItemId);
-    wxPostEvent(pParent, taskInsertedEvent);
+    event.SetEventType(EVT_TASK_ITEM_DELETED);
+    wxPostEvent(pParent, event);
 }
 
 void TaskItemDialog::OnDateContextChange(wxDateEvent& event)
@@ -745,6 +841,9 @@ void TaskItemDialog::OnIsActiveCheck(wxCommandEvent& event)
 void TaskItemDialog::OnOk(wxCommandEvent& event)
 {
     if (TransferDataAndValidate()) {
+        /* Snapshot the row before the model is handed over to the data layer */
+        TaskItemEvent taskItemEvent = CreateTaskItemEvent();
+
         if (!bIsEdit) {
             int64_t id = -1;
             try {
@@ -754,8 +853,10 @@ void TaskItemDialog::OnOk(wxCommandEvent& event)
                 pLogger->error("Error occured in TaskItemModel::Create() - {0:d} : {1}", e.get_code(), e.what());
                 wxLogDebug(wxString(e.get_sql()));
                 EndModal(ids::ID_ERROR_OCCURED);
+                return;
             }
-            GenerateTaskInsertedEvent(id);
+            taskItemEvent.SetTaskItemId(static_cast<int>(id));
+            GenerateTaskInsertedEvent(taskItemEvent);
         }
 
         if (bIsEdit && pIsActiveCtrl->IsChecked()) {
@@ -765,8 +866,9 @@ void TaskItemDialog::OnOk(wxCommandEvent& event)
                 pLogger->error("Error occured in TaskItemModel::Update() - {0:d} : {1}", e.get_code(), e.what());
                 wxLogDebug(wxString(e.get_sql()));
                 EndModal(ids::ID_ERROR_OCCURED);
+                return;
             }
-            GenerateTaskUpdatedEvent(mTaskItemId);
+            GenerateTaskUpdatedEvent(taskItemEvent);
         }
 
         if (bIsEdit && !pIsActiveCtrl->IsChecked()) {
@@ -776,8 +878,9 @@ void TaskItemDialog::OnOk(wxCommandEvent& event)
                 pLogger->error("Error occured in TaskItemModel::Delete() - {0:d} : {1}", e.get_code(), e.what());
                 wxLogDebug(wxString(e.get_sql()));
                 EndModal(ids::ID_ERROR_OCCURED);
+                return;
             }
-            GenerateTaskDeletedEvent(mTaskItemId);
+            GenerateTaskDeletedEvent(taskItemEvent);
         }
 
         EndModal(wxID_OK);
@@ -802,6 +905,7 @@ void TaskItemDialog::FillCategoryControl(int projectId)
 
     for (auto& category : categories) {
         pCategoryChoiceCtrl->Append(category->GetName(), util::IntToVoidPointer(category->GetCategoryId()));
+        mCategoryColors[category->GetCategoryId()] = category->GetColor();
     }
 
     if (!pCategoryChoiceCtrl->IsEnabled()) {
@@ -855,7 +959,7 @@ bool TaskItemDialog::TransferDataAndValidate()
 
         pTaskItem->SetStartTime(std::move(std::make_unique<wxDateTime>(startTime)));
         pTaskItem->SetEndTime(std::move(std::make_unique<wxDateTime>(endTime)));
-        pTaskItem->SetDuration(pDurationCtrl->GetLabel());
+        pTaskItem->SetDuration(common::Duration::Parse(pDurationCtrl->GetLabel()));
     }
     if (mType == constants::TaskItemTypes::EntryTask) {
         auto hours = pDurationHoursCtrl->GetValue();
@@ -867,8 +971,7 @@ bool TaskItemDialog::TransferDataAndValidate()
             }
         }
 
-        auto asFormattedTime = wxString::Format("%02d:%02d:00", hours, minutes);
-        pTaskItem->SetDuration(asFormattedTime);
+        pTaskItem->SetDuration(common::Duration::FromHoursMinutesSeconds(hours, minutes, 0));
     }
 
     if (pCategoryChoiceCtrl->GetCount() <= 1) {
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include <wx/wx.h>
 #include <wx/spinctrl.h>
@@ -40,9 +41,48 @@ class wxDateEvent;
 class wxDatePickerCtrl;
 class wxTimePickerCtrl;
 
-wxDECLARE_EVENT(EVT_TASK_ITEM_INSERTED, wxCommandEvent);
-wxDECLARE_EVENT(EVT_TASK_ITEM_UPDATED, wxCommandEvent);
-wxDECLARE_EVENT(EVT_TASK_ITEM_DELETED, wxCommandEvent);
+namespace app::dlg
+{
+/* Carries the saved row so listeners can update their views without re-querying the database */
+class TaskItemEvent final : public wxCommandEvent
+{
+public:
+    TaskItemEvent(wxEventType eventType = wxEVT_NULL, int taskItemId = -1);
+    TaskItemEvent(const TaskItemEvent& event) = default;
+    virtual ~TaskItemEvent() = default;
+
+    wxEvent* Clone() const override;
+
+    int GetTaskItemId() const;
+    wxString GetTaskDate() const;
+    wxString GetProjectName() const;
+    common::Duration GetDuration() const;
+    wxString GetCategoryName() const;
+    wxColor GetCategoryColor() const;
+    wxString GetDescription() const;
+
+    void SetTaskItemId(int taskItemId);
+    void SetTaskDate(const wxString& taskDate);
+    void SetProjectName(const wxString& projectName);
+    void SetDuration(common::Duration duration);
+    void SetCategoryName(const wxString& categoryName);
+    void SetCategoryColor(const wxColor& categoryColor);
+    void SetDescription(const wxString& description);
+
+private:
+    int mTaskItemId;
+    wxString mTaskDate;
+    wxString mProjectName;
+    common::Duration mDuration;
+    wxString mCategoryName;
+    wxColor mCategoryColor;
+    wxString mDescription;
+};
+} // namespace app::dlg
+
+wxDECLARE_EVENT(EVT_TASK_ITEM_INSERTED, app::dlg::TaskItemEvent);
+wxDECLARE_EVENT(EVT_TASK_ITEM_UPDATED, app::dlg::TaskItemEvent);
+wxDECLARE_EVENT(EVT_TASK_ITEM_DELETED, app::dlg::TaskItemEvent);
 
 namespace app::dlg
 {
@@ -99,9 +139,10 @@ class TaskItemDialog : public wxDialog
 
     void CalculateTimeDiff(wxDateTime start, wxDateTime end);
 
-    void GenerateTaskInsertedEvent(int taskItemId);
-    void GenerateTaskUpdatedEvent(int taskItemId);
-    void GenerateTaskDeletedEvent(int taskItemId);
+    TaskItemEvent CreateTaskItemEvent();
+    void GenerateTaskInsertedEvent(TaskItemEvent& event);
+    void GenerateTaskUpdatedEvent(TaskItemEvent& event);
+    void GenerateTaskDeletedEvent(TaskItemEvent& event);
 
     bool TransferDataAndValidate();
 
@@ -132,6 +173,7 @@ class TaskItemDialog : public wxDialog
 
     std::unique_ptr<model::TaskItemModel> pTaskItem;
     std::unique_ptr<model::ProjectModel> pProject;
+    std::unordered_map<int, wxColor> mCategoryColors;
 
     data::ProjectData mProjectData;
     data::TaskItemData mTaskItemData;
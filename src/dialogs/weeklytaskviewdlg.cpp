@@ -19,6 +19,7 @@
 
 #include "weeklytaskviewdlg.h"
 
+#include <sqlite_modern_cpp/errors.h>
 #include <wx/utils.h>
 #include <wx/clipbrd.h>
 
@@ -30,18 +31,23 @@
 
 #include "../dialogs/taskitemdlg.h"
 
+wxDEFINE_EVENT(WEEK_PREFETCH_THREAD_COMPLETED, wxThreadEvent);
+
 namespace app::dlg
 {
+/* Enough for a few weeks either side of the one being viewed */
+const std::size_t WeekCacheCapacity = 8;
+
 const wxString WeekLabel = wxT("Monday %s - Sunday %s");
 const wxString SelectedDateLabel = wxT("%s");
 wxString DayHoursLabels[7] = {
-    wxT("Monday: %H:%M:%S"),
-    wxT("Tuesday: %H:%M:%S"),
-    wxT("Wednesday: %H:%M:%S"),
-    wxT("Thursday: %H:%M:%S"),
-    wxT("Friday: %H:%M:%S"),
-    wxT("Saturday: %H:%M:%S"),
-    wxT("Sunday: %H:%M:%S"),
+    wxT("Monday: %s"),
+    wxT("Tuesday: %s"),
+    wxT("Wednesday: %s"),
+    wxT("Thursday: %s"),
+    wxT("Friday: %s"),
+    wxT("Saturday: %s"),
+    wxT("Sunday: %s"),
 };
 
 wxString DayLabels[7] = {
@@ -54,10 +60,59 @@ wxString DayLabels[7] = {
     wxT("Sunday"),
 };
 
+WeekPrefetchThread::WeekPrefetchThread(WeeklyTaskViewDialog* handler,
+    std::shared_ptr<spdlog::logger> logger,
+    std::shared_ptr<svc::WeekCache> weekCache,
+    std::vector<common::CivilDate> mondayDates)
+    : wxThread(wxTHREAD_DETACHED)
+    , pHandler(handler)
+    , pLogger(logger)
+    , pWeekCache(weekCache)
+    , mMondayDates(mondayDates)
+{
+}
+
+WeekPrefetchThread::~WeekPrefetchThread()
+{
+    wxCriticalSectionLocker enter(pHandler->mCriticalSection);
+    pHandler->pThread = nullptr;
+}
+
+wxThread::ExitCode WeekPrefetchThread::Entry()
+{
+    for (auto mondayDate : mMondayDates) {
+        if (TestDestroy()) {
+            return (wxThread::ExitCode) 0;
+        }
+
+        if (pWeekCache->Contains(mondayDate)) {
+            continue;
+        }
+
+        std::uint64_t generation = pWeekCache->GetGeneration();
+        try {
+            pWeekCache->Put(mondayDate, svc::WeekCache::Load(mondayDate), generation);
+        } catch (const sqlite::sqlite_exception& e) {
+            pLogger->error("Error occured on WeekCache::Load({0}) - {1:d} : {2}",
+                mondayDate.ToStdString(),
+                e.get_code(),
+                e.what());
+            return (wxThread::ExitCode) 1;
+        }
+    }
+
+    auto event = new wxThreadEvent(WEEK_PREFETCH_THREAD_COMPLETED);
+    wxQueueEvent(pHandler, event);
+
+    return (wxThread::ExitCode) 0;
+}
+
 WeeklyTaskViewDialog::WeeklyTaskViewDialog(wxWindow* parent,
     std::shared_ptr<spdlog::logger> logger,
     const wxString& name)
-    : pParent(parent)
+    : pThread(nullptr)
+    , mCriticalSection()
+    , pParent(parent)
     , pLogger(logger)
     , pWeekDatesLabel(nullptr)
     , pCalendarCtrl(nullptr)
@@ -66,6 +121,7 @@ WeeklyTaskViewDialog::WeeklyTaskViewDialog(wxWindow* parent,
     , pWeeklyTreeModel(nullptr)
     , pDataViewCtrl(nullptr)
     , mDateTraverser()
+    , pWeekCache(std::make_shared<svc::WeekCache>(WeekCacheCapacity))
     , mSelectedTaskItemId(-1)
     , mDaySelected(wxDefaultDateTime)
 {
@@ -75,6 +131,11 @@ WeeklyTaskViewDialog::WeeklyTaskViewDialog(wxWindow* parent,
     SetMinSize(dialogSize);
 }
 
+WeeklyTaskViewDialog::~WeeklyTaskViewDialog()
+{
+    ThreadCleanupProcedure();
+}
+
 bool WeeklyTaskViewDialog::Create(wxWindow* parent,
     wxWindowID windowId,
     const wxString& title,
@@ -260,29 +321,47 @@ void WeeklyTaskViewDialog::ConfigureEventBindings()
         this,
         wxID_DELETE
     );
+
+    Bind(
+        EVT_TASK_ITEM_UPDATED,
+        &WeeklyTaskViewDialog::OnTaskUpdated,
+        this
+    );
+
+    Bind(
+        EVT_TASK_ITEM_DELETED,
+        &WeeklyTaskViewDialog::OnTaskDeleted,
+        this
+    );
+
+    Bind(
+        WEEK_PREFETCH_THREAD_COMPLETED,
+        &WeeklyTaskViewDialog::OnPrefetchCompletion,
+        this
+    );
 }
 // clang-format on
 
 void WeeklyTaskViewDialog::FillControls()
 {
-    wxString mondayISODateString = mDateTraverser.GetDayISODate(constants::Days::Monday);
-    wxString sundayISODateString = mDateTraverser.GetDayISODate(constants::Days::Sunday);
-
-    pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel, mondayISODateString, sundayISODateString));
+    pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel,
+        mDateTraverser.GetDayISODate(constants::Days::Monday),
+        mDateTraverser.GetDayISODate(constants::Days::Sunday)));
 
     {
         wxWindowDisabler disableAll;
         wxBusyCursor wait;
-        GetTaskItemsForDailyBreakdown();
-        GetTaskItemsByDateRange(mondayISODateString, sundayISODateString);
-        GetTaskItemHoursByDateRange(mondayISODateString, sundayISODateString);
+        LoadWeek();
     }
     pDataViewCtrl->Expand(pWeeklyTreeModel->ExpandRootNode());
+
+    PrefetchAdjacentWeeks();
 }
 
 void WeeklyTaskViewDialog::OnCalendarWeekSelection(wxCalendarEvent& event)
 {
-    if (event.GetDate().FormatISODate() == mDateTraverser.GetDayISODate(constants::Days::Monday)) {
+    common::CivilDate selectedDate = common::CivilDate::FromDateTime(event.GetDate());
+    if (selectedDate.GetMonday() == mDateTraverser.GetDay(constants::Days::Monday)) {
         return;
     }
 
@@ -290,24 +369,23 @@ void WeeklyTaskViewDialog::OnCalendarWeekSelection(wxCalendarEvent& event)
         wxWindowDisabler disableAll;
         wxBusyCursor wait;
 
-        mDateTraverser.Recalculate(event.GetDate());
+        mDateTraverser.Recalculate(selectedDate);
         pWeeklyTreeModel->SetDateTraverser(mDateTraverser);
         pWeeklyTreeModel->ClearAll();
         for (auto& item : pWeeklyTreeModel->CollapseDayNodes()) {
             pDataViewCtrl->Collapse(item);
         }
 
-        wxString mondayISODateString = mDateTraverser.GetDayISODate(constants::Days::Monday);
-        wxString sundayISODateString = mDateTraverser.GetDayISODate(constants::Days::Sunday);
-
-        pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel, mondayISODateString, sundayISODateString));
+        pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel,
+            mDateTraverser.GetDayISODate(constants::Days::Monday),
+            mDateTraverser.GetDayISODate(constants::Days::Sunday)));
 
-        GetTaskItemsForDailyBreakdown();
-        GetTaskItemsByDateRange(mondayISODateString, sundayISODateString);
-        GetTaskItemHoursByDateRange(mondayISODateString, sundayISODateString);
+        LoadWeek();
     }
 
     pDataViewCtrl->Refresh();
+
+    PrefetchAdjacentWeeks();
 }
 
 void WeeklyTaskViewDialog::OnContextMenu(wxDataViewEvent& event)
@@ -386,80 +464,148 @@ void WeeklyTaskViewDialog::OnContextMenuDelete(wxCommandEvent& WXUNUSED(event))
     }
 
     pWeeklyTreeModel->Delete(mSelectedDataViewItem);
+
+    RefreshDurationTotals();
 }
 
-void WeeklyTaskViewDialog::GetTaskItemsForDailyBreakdown()
+void WeeklyTaskViewDialog::OnTaskUpdated(TaskItemEvent& event)
 {
-    const auto& dateArray = mDateTraverser.GetISODates();
-    data::TaskItemData taskItemData;
-    for (std::size_t i = 0; i <= constants::Sunday; i++) {
-        std::vector<wxString> durations;
-        try {
-            durations = taskItemData.GetHours(dateArray[i]);
-        } catch (const sqlite::sqlite_exception& e) {
-            pLogger->error("Error occured on TaskItemData::GetHours({0}) - {1:d} : {2}",
-                dateArray[i].ToStdString(),
-                e.get_code(),
-                e.what());
-        }
-
-        wxTimeSpan totalDuration;
-        for (auto& duration : durations) {
-            std::vector<std::string> durationSplit = util::lib::split(duration.ToStdString(), ':');
+    pWeeklyTreeModel->Change(event.GetTaskItemId(),
+        event.GetTaskDate(),
+        event.GetProjectName(),
+        event.GetDuration(),
+        event.GetCategoryName(),
+        event.GetDescription());
+
+    RefreshDurationTotals();
+}
 
-            wxTimeSpan currentDuration(std::atol(durationSplit[0].c_str()),
-                std::atol(durationSplit[1].c_str()),
-                (wxLongLong) std::atoll(durationSplit[2].c_str()));
+void WeeklyTaskViewDialog::OnTaskDeleted(TaskItemEvent& event)
+{
+    pWeeklyTreeModel->Delete(event.GetTaskItemId());
 
-            totalDuration += currentDuration;
-        }
+    RefreshDurationTotals();
+}
 
-        pDailyHoursBreakdownTextCtrlArray[i]->SetLabel(totalDuration.Format(DayHoursLabels[i]));
-    }
+void WeeklyTaskViewDialog::OnPrefetchCompletion(wxThreadEvent& WXUNUSED(event))
+{
+    /* The selected week may have moved on while the thread was busy */
+    PrefetchAdjacentWeeks();
 }
 
-void WeeklyTaskViewDialog::GetTaskItemsByDateRange(const wxString& fromDate, const wxString& toDate)
+void WeeklyTaskViewDialog::LoadWeek()
 {
-    data::TaskItemData taskItemData;
-    std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
     try {
-        taskItems = taskItemData.GetByWeek(fromDate, toDate);
+        pWeekCache->ClearIfDataVersionChanged();
     } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured on TaskItemData::GetByWeek({0}, {1}) - {2:d} : {3}",
-            fromDate.ToStdString(),
-            toDate.ToStdString(),
-            e.get_code(),
-            e.what());
+        pLogger->error("Error occured on WeekCache::ClearIfDataVersionChanged() - {0:d} : {1}", e.get_code(), e.what());
+    }
+
+    common::CivilDate mondayDate = mDateTraverser.GetDay(constants::Days::Monday);
+
+    auto week = pWeekCache->Get(mondayDate);
+    if (!week) {
+        week = LoadWeekResult(mondayDate);
     }
 
-    pWeeklyTreeModel->AddToWeek(taskItems);
+    if (week) {
+        pWeeklyTreeModel->AddToWeek(week->TaskItems);
+        UpdateDurationLabels(*week);
+    }
 }
 
-void WeeklyTaskViewDialog::GetTaskItemHoursByDateRange(const wxString& fromDate, const wxString& toDate)
+std::shared_ptr<const svc::WeekResult> WeeklyTaskViewDialog::LoadWeekResult(common::CivilDate mondayDate)
 {
-    data::TaskItemData taskItemData;
-    std::vector<wxString> durations;
+    std::uint64_t generation = pWeekCache->GetGeneration();
+
+    std::shared_ptr<const svc::WeekResult> week = nullptr;
     try {
-        durations = taskItemData.GetHoursByWeek(fromDate, toDate);
+        week = svc::WeekCache::Load(mondayDate);
     } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured on TaskItemData::GetHoursByWeek({0}, {1}) - {2:d} : {3}",
-            fromDate.ToStdString(),
-            toDate.ToStdString(),
+        pLogger->error("Error occured on WeekCache::Load({0}) - {1:d} : {2}",
+            mondayDate.ToStdString(),
             e.get_code(),
             e.what());
+        return nullptr;
+    }
+
+    pWeekCache->Put(mondayDate, week, generation);
+
+    return week;
+}
+
+void WeeklyTaskViewDialog::RefreshDurationTotals()
+{
+    common::CivilDate mondayDate = mDateTraverser.GetDay(constants::Days::Monday);
+    pWeekCache->Invalidate(mondayDate);
+
+    auto week = LoadWeekResult(mondayDate);
+    if (week) {
+        UpdateDurationLabels(*week);
+    }
+}
+
+void WeeklyTaskViewDialog::UpdateDurationLabels(const svc::WeekResult& week)
+{
+    for (std::size_t i = 0; i <= constants::Sunday; i++) {
+        pDailyHoursBreakdownTextCtrlArray[i]->SetLabel(
+            wxString::Format(DayHoursLabels[i], week.DayDurations[i].ToString()));
+    }
+
+    pTotalWeekHoursLabel->SetLabel(wxString::Format(constants::TotalHours, week.TotalDuration.ToString()));
+}
+
+void WeeklyTaskViewDialog::PrefetchAdjacentWeeks()
+{
+    {
+        wxCriticalSectionLocker enter(mCriticalSection);
+        if (pThread) {
+            return;
+        }
+    }
+
+    common::CivilDate mondayDate = mDateTraverser.GetDay(constants::Days::Monday);
+    std::array<common::CivilDate, 2> adjacentMondayDates = { mondayDate.AddWeeks(-1), mondayDate.AddWeeks(1) };
+
+    std::vector<common::CivilDate> mondayDates;
+    for (auto adjacentMondayDate : adjacentMondayDates) {
+        if (!pWeekCache->Contains(adjacentMondayDate)) {
+            mondayDates.push_back(adjacentMondayDate);
+        }
     }
 
-    wxTimeSpan totalDuration;
-    for (auto& duration : durations) {
-        std::vector<std::string> durationSplit = util::lib::split(duration.ToStdString(), ':');
+    if (mondayDates.empty()) {
+        return;
+    }
 
-        wxTimeSpan currentDuration(std::atol(durationSplit[0].c_str()),
-            std::atol(durationSplit[1].c_str()),
-            (wxLongLong) std::atoll(durationSplit[2].c_str()));
+    pThread = new WeekPrefetchThread(this, pLogger, pWeekCache, mondayDates);
+    auto ret = pThread->Run();
+    if (ret != wxTHREAD_NO_ERROR) {
+        delete pThread;
+        pThread = nullptr;
+    }
+}
 
-        totalDuration += currentDuration;
+void WeeklyTaskViewDialog::ThreadCleanupProcedure()
+{
+    {
+        wxCriticalSectionLocker enter(mCriticalSection);
+        if (pThread) {
+            auto ret = pThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                wxLogError("Cannot delete thread!");
+            }
+        }
     }
 
-    pTotalWeekHoursLabel->SetLabel(totalDuration.Format(constants::TotalHours));
+    while (1) {
+        {
+            wxCriticalSectionLocker enter(mCriticalSection);
+            if (!pThread) {
+                break;
+            }
+        }
+        wxThread::This()->Sleep(1);
+    }
 }
 } // namespace app::dlg
@@ -21,10 +21,12 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include <wx/wx.h>
 #include <wx/calctrl.h>
 #include <wx/dataview.h>
+#include <wx/thread.h>
 
 #ifdef wxHAS_NATIVE_CALENDARCTRL
 #include <wx/generic/calctrlg.h>
@@ -32,12 +34,39 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/civildate.h"
 #include "../common/datetraverser.h"
 #include "../config/configuration.h"
 #include "../dataview/weeklymodel.h"
+#include "../services/weekcache.h"
+
+wxDECLARE_EVENT(WEEK_PREFETCH_THREAD_COMPLETED, wxThreadEvent);
 
 namespace app::dlg
 {
+class TaskItemEvent;
+class WeeklyTaskViewDialog;
+
+class WeekPrefetchThread final : public wxThread
+{
+public:
+    WeekPrefetchThread() = delete;
+    WeekPrefetchThread(WeeklyTaskViewDialog* handler,
+        std::shared_ptr<spdlog::logger> logger,
+        std::shared_ptr<svc::WeekCache> weekCache,
+        std::vector<common::CivilDate> mondayDates);
+    virtual ~WeekPrefetchThread();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    WeeklyTaskViewDialog* pHandler;
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<svc::WeekCache> pWeekCache;
+    std::vector<common::CivilDate> mMondayDates;
+};
+
 class WeeklyTaskViewDialog final : public wxDialog
 {
 public:
@@ -45,7 +74,11 @@ class WeeklyTaskViewDialog final : public wxDialog
     WeeklyTaskViewDialog(wxWindow* parent,
         std::shared_ptr<spdlog::logger> logger,
         const wxString& name = wxT("weeklytaskviewdlg"));
-    virtual ~WeeklyTaskViewDialog() = default;
+    virtual ~WeeklyTaskViewDialog();
+
+protected:
+    WeekPrefetchThread* pThread;
+    wxCriticalSection mCriticalSection;
 
 private:
     bool Create(wxWindow* parent,
@@ -65,10 +98,19 @@ class WeeklyTaskViewDialog final : public wxDialog
     void OnContextMenuCopyToClipboard(wxCommandEvent& event);
     void OnContextMenuEdit(wxCommandEvent& event);
     void OnContextMenuDelete(wxCommandEvent& event);
+    void OnTaskUpdated(TaskItemEvent& event);
+    void OnTaskDeleted(TaskItemEvent& event);
+    void OnPrefetchCompletion(wxThreadEvent& event);
+
+    void LoadWeek();
+    std::shared_ptr<const svc::WeekResult> LoadWeekResult(common::CivilDate mondayDate);
+    void RefreshDurationTotals();
+    void UpdateDurationLabels(const svc::WeekResult& week);
+
+    void PrefetchAdjacentWeeks();
+    void ThreadCleanupProcedure();
 
-    void GetTaskItemsForDailyBreakdown();
-    void GetTaskItemsByDateRange(const wxString& fromDate, const wxString& toDate);
-    void GetTaskItemHoursByDateRange(const wxString& fromDate, const wxString& toDate);
+    friend class WeekPrefetchThread;
 
     std::shared_ptr<spdlog::logger> pLogger;
 
@@ -81,6 +123,7 @@ class WeeklyTaskViewDialog final : public wxDialog
     wxDataViewCtrl* pDataViewCtrl;
 
     DateTraverser mDateTraverser;
+    std::shared_ptr<svc::WeekCache> pWeekCache;
 
     wxDataViewItem mSelectedDataViewItem;
     int mSelectedTaskItemId;
@@ -19,6 +19,7 @@
 
 #include "mainframe.h"
 
+#include <chrono>
 #include <vector>
 
 #include <sqlite_modern_cpp/errors.h>
@@ -27,14 +28,17 @@
 #include <wx/clipbrd.h>
 #include <wx/taskbarbutton.h>
 
+#include "../common/civildate.h"
 #include "../common/constants.h"
 #include "../common/common.h"
 #include "../common/ids.h"
+#include "../common/phasetimer.h"
 #include "../common/resources.h"
 #include "../common/util.h"
 #include "../common/version.h"
 
 #include "../data/taskitemdata.h"
+#include "../database/connectionprovider.h"
 #include "../models/taskitemmodel.h"
 
 #include "../dialogs/taskitemdlg.h"
@@ -48,6 +52,7 @@
 #include "../dialogs/categoriesdlg.h"
 
 #include "../dialogs/weeklytaskviewdlg.h"
+#include "../dialogs/aggregateviewdlg.h"
 //#include "../dialogs/meetingsviewdlg.h"
 
 #include "../dialogs/preferencesdlg.h"
@@ -57,9 +62,13 @@
 #include "../wizards/databaserestorewizard.h"
 #include "taskbaricon.h"
 
+#include "../services/backupdirectorylock.h"
 #include "../services/databasebackup.h"
 #include "../services/databasebackupdeleter.h"
 
+wxDEFINE_EVENT(DATABASE_BACKUP_THREAD_PROGRESS, wxThreadEvent);
+wxDEFINE_EVENT(DATABASE_BACKUP_THREAD_COMPLETED, wxThreadEvent);
+
 namespace app::frm
 {
 // clang-format off
@@ -69,6 +78,7 @@ EVT_CLOSE(MainFrame::OnClose)
 EVT_ICONIZE(MainFrame::OnIconize)
 EVT_SIZE(MainFrame::OnResize)
 EVT_TIMER(IDC_DISMISS_INFOBAR_TIMER, MainFrame::OnDismissInfoBar)
+EVT_TIMER(IDC_BACKUP_SCHEDULE_TIMER, MainFrame::OnBackupScheduleTimer)
 /* Main Menu Event Handlers */
 EVT_MENU(wxID_ABOUT, MainFrame::OnAbout)
 EVT_MENU(wxID_EXIT, MainFrame::OnExit)
@@ -79,6 +89,7 @@ EVT_MENU(ids::ID_NEW_PROJECT, MainFrame::OnNewProject)
 EVT_MENU(ids::ID_NEW_CLIENT, MainFrame::OnNewClient)
 EVT_MENU(ids::ID_NEW_CATEGORY, MainFrame::OnNewCategory)
 EVT_MENU(ids::ID_WEEKLY_VIEW, MainFrame::OnWeeklyView)
+EVT_MENU(ids::ID_AGGREGATE_VIEW, MainFrame::OnAggregateView)
 //EVT_MENU(ids::ID_MEETINGS_VIEW, MainFrame::OnMeetingsView)
 EVT_MENU(ids::ID_EDIT_EMPLOYER, MainFrame::OnEditEmployer)
 EVT_MENU(ids::ID_EDIT_CLIENT, MainFrame::OnEditClient)
@@ -105,20 +116,111 @@ EVT_MENU(wxID_COPY, MainFrame::OnPopupMenuCopyToClipboard)
 EVT_MENU(wxID_EDIT, MainFrame::OnPopupMenuEdit)
 EVT_MENU(wxID_DELETE, MainFrame::OnPopupMenuDelete)
 /* Uncategorized Event Handlers */
-EVT_COMMAND(wxID_ANY, EVT_TASK_ITEM_INSERTED, MainFrame::OnTaskInserted)
-EVT_COMMAND(wxID_ANY, EVT_TASK_ITEM_UPDATED, MainFrame::OnTaskUpdated)
-EVT_COMMAND(wxID_ANY, EVT_TASK_ITEM_DELETED, MainFrame::OnTaskDeleted)
 EVT_COMMAND(wxID_ANY, START_NEW_STOPWATCH_TASK, MainFrame::OnNewStopwatchTaskFromPausedStopwatchTask)
 wxEND_EVENT_TABLE()
+// clang-format on
+
+DatabaseBackupThread::DatabaseBackupThread(MainFrame* handler, std::shared_ptr<spdlog::logger> logger)
+    : wxThread(wxTHREAD_DETACHED)
+    , pHandler(handler)
+    , pLogger(logger)
+{
+}
+
+DatabaseBackupThread::~DatabaseBackupThread()
+{
+    wxCriticalSectionLocker enter(pHandler->mBackupCriticalSection);
+    pHandler->pBackupThread = nullptr;
+}
+
+wxThread::ExitCode DatabaseBackupThread::Entry()
+{
+    /* the snapshot, retention and chunk collection run one after the other under a lock the command line shares */
+    svc::BackupDirectoryLock backupDirectoryLock(
+        pLogger, cfg::ConfigurationProvider::Get().Configuration->GetBackupPath());
+    if (!backupDirectoryLock.Acquire(std::chrono::minutes(1), [&]() { return TestDestroy(); })) {
+        auto event = new wxThreadEvent(DATABASE_BACKUP_THREAD_COMPLETED);
+        event->SetInt(0);
+        wxQueueEvent(pHandler, event);
+
+        return (wxThread::ExitCode) 0;
+    }
+
+    /* the backup acquires its own connection from the pool for the lifetime of this thread */
+    svc::DatabaseBackup databaseBackup(pLogger);
+
+    int lastPercentage = -1;
+    bool result = databaseBackup.Execute([&](int remainingPages, int pageCount) {
+        if (TestDestroy()) {
+            return false;
+        }
+
+        int percentage = pageCount > 0 ? (pageCount - remainingPages) * 100 / pageCount : 100;
+        if (percentage != lastPercentage) {
+            lastPercentage = percentage;
+
+            auto progressEvent = new wxThreadEvent(DATABASE_BACKUP_THREAD_PROGRESS);
+            progressEvent->SetInt(percentage);
+            wxQueueEvent(pHandler, progressEvent);
+        }
+
+        return true;
+    });
+
+    /* retention only changes once a new backup exists, and checksumming or collecting chunks stays off the UI thread */
+    if (result && !TestDestroy()) {
+        svc::DatabaseBackupDeleter databaseBackupDeleter(pLogger);
+        if (!databaseBackupDeleter.Execute()) {
+            pLogger->warn("Applying backup retention encountered error(s)");
+        }
+    }
+
+    auto event = new wxThreadEvent(DATABASE_BACKUP_THREAD_COMPLETED);
+    event->SetInt(result ? 1 : 0);
+    wxQueueEvent(pHandler, event);
 
+    return (wxThread::ExitCode) 0;
+}
+
+StartupTasksThread::StartupTasksThread(MainFrame* handler, std::shared_ptr<spdlog::logger> logger)
+    : wxThread(wxTHREAD_DETACHED)
+    , pHandler(handler)
+    , pLogger(logger)
+{
+}
+
+StartupTasksThread::~StartupTasksThread()
+{
+    wxCriticalSectionLocker enter(pHandler->mStartupCriticalSection);
+    pHandler->pStartupThread = nullptr;
+}
+
+wxThread::ExitCode StartupTasksThread::Entry()
+{
+    common::PhaseTimer backgroundTimer;
+
+    db::ConnectionProvider::Get().Handle()->Prefill();
+    backgroundTimer.Mark("connections");
+
+    pLogger->info("Background startup tasks: {0}", backgroundTimer.ToString());
+
+    return (wxThread::ExitCode) 0;
+}
+
+// clang-format off
 MainFrame::MainFrame(std::shared_ptr<spdlog::logger> logger,
     const wxString& name)
     :wxFrame(
         nullptr, wxID_ANY, common::GetProgramName(), wxDefaultPosition, wxSize(600, 500), wxDEFAULT_FRAME_STYLE, name)
+    , pBackupThread(nullptr)
+    , mBackupCriticalSection()
+    , pStartupThread(nullptr)
+    , mStartupCriticalSection()
     , pLogger(logger)
     , pTaskState(std::make_shared<services::TaskStateService>())
     , pTaskStorage(std::make_unique<services::TaskStorage>())
     , pDismissInfoBarTimer(std::make_unique<wxTimer>(this, IDC_DISMISS_INFOBAR_TIMER))
+    , pBackupScheduleTimer(std::make_unique<wxTimer>(this, IDC_BACKUP_SCHEDULE_TIMER))
     , pPrevDayBtn(nullptr)
     , pDatePickerCtrl(nullptr)
     , pNextDayBtn(nullptr)
@@ -132,6 +234,10 @@ MainFrame::MainFrame(std::shared_ptr<spdlog::logger> logger,
     , pFeedbackPopupWindow(nullptr)
     , mItemIndex(-1)
     , mSelectedTaskItemId(-1)
+    , mTotalDuration()
+    , mTaskItemDurations()
+    , mLastBackupTime()
+    , bManualBackup(false)
 // clang-format on
 {
 }
@@ -143,13 +249,16 @@ MainFrame::~MainFrame()
     int h = size.GetHeight();
     auto newSize = wxString::Format(wxT("%s,%s"), std::to_string(w), std::to_string(h));
     cfg::ConfigurationProvider::Get().Configuration->SetFrameSize(newSize.ToStdString());
-    cfg::ConfigurationProvider::Get().Configuration->Save();
+    cfg::ConfigurationProvider::Get().Configuration->Flush();
 
     if (pTaskBarIcon) {
         delete pTaskBarIcon;
     }
 
-    RunDatabaseBackup();
+    /* backups are taken on a schedule while the application is idle, so closing never waits for one */
+    pBackupScheduleTimer->Stop();
+    BackupThreadCleanupProcedure();
+    StartupThreadCleanupProcedure();
 }
 
 bool MainFrame::CreateFrame()
@@ -166,23 +275,56 @@ bool MainFrame::CreateFrame()
     wxIconBundle iconBundle("AppIcon", 0);
     SetIcons(iconBundle);
 
-    if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled()) {
-        svc::DatabaseBackupDeleter dbBackupDeleter;
-        dbBackupDeleter.Execute();
-    }
-
     pTaskBarIcon = new TaskBarIcon(this, pLogger);
     if (cfg::ConfigurationProvider::Get().Configuration->IsShowInTray()) {
         pTaskBarIcon->SetTaskBarIcon();
     }
 
+    pBackupScheduleTimer->Start(BackupScheduleCheckInterval);
+
     return success;
 }
 
+void MainFrame::LoadStartupData()
+{
+    DataToControls();
+}
+
+void MainFrame::StartBackgroundStartupTasks()
+{
+    wxCriticalSectionLocker enter(mStartupCriticalSection);
+    if (pStartupThread) {
+        return;
+    }
+
+    pStartupThread = new StartupTasksThread(this, pLogger);
+    auto ret = pStartupThread->Run();
+    if (ret != wxTHREAD_NO_ERROR) {
+        delete pStartupThread;
+        pStartupThread = nullptr;
+
+        pLogger->error("Failed to start the startup tasks thread");
+    }
+}
+
+void MainFrame::WatchConfigFile()
+{
+    /* wxFileSystemWatcher needs a running event loop, so it cannot be created along with the frame */
+    wxFileName configFileName(common::GetConfigFilePath());
+
+    pConfigWatcher = std::make_unique<wxFileSystemWatcher>();
+    pConfigWatcher->SetOwner(this);
+    if (!pConfigWatcher->Add(wxFileName::DirName(configFileName.GetPath()),
+            wxFSW_EVENT_CREATE | wxFSW_EVENT_MODIFY | wxFSW_EVENT_RENAME)) {
+        pLogger->warn("Failed to watch {0} for changes", configFileName.GetFullPath().ToStdString());
+        pConfigWatcher.reset();
+    }
+}
+
 bool MainFrame::Create()
 {
     CreateControls();
-    DataToControls();
+    ConfigureEventBindings();
 
     return true;
 }
@@ -233,6 +375,7 @@ void MainFrame::CreateControls()
     fileMenu->AppendSeparator();
     auto fileViewMenu = new wxMenu();
     fileViewMenu->Append(ids::ID_WEEKLY_VIEW, wxT("Week View"));
+    fileViewMenu->Append(ids::ID_AGGREGATE_VIEW, wxT("Month and Year View"));
     //fileViewMenu->Append(ids::ID_MEETINGS_VIEW, wxT("Meetings View"));
     fileMenu->AppendSubMenu(fileViewMenu, wxT("View"));
     fileMenu->AppendSeparator();
@@ -373,10 +516,51 @@ void MainFrame::CreateControls()
     pListCtrl->InsertColumn(4, descriptionColumn);
 }
 
+// clang-format off
+void MainFrame::ConfigureEventBindings()
+{
+    Bind(
+        EVT_TASK_ITEM_INSERTED,
+        &MainFrame::OnTaskInserted,
+        this
+    );
+
+    Bind(
+        EVT_TASK_ITEM_UPDATED,
+        &MainFrame::OnTaskUpdated,
+        this
+    );
+
+    Bind(
+        EVT_TASK_ITEM_DELETED,
+        &MainFrame::OnTaskDeleted,
+        this
+    );
+
+    Bind(
+        DATABASE_BACKUP_THREAD_PROGRESS,
+        &MainFrame::OnBackupThreadProgress,
+        this
+    );
+
+    Bind(
+        DATABASE_BACKUP_THREAD_COMPLETED,
+        &MainFrame::OnBackupThreadCompletion,
+        this
+    );
+
+    Bind(
+        wxEVT_FSWATCHER,
+        &MainFrame::OnConfigFileChanged,
+        this
+    );
+}
+// clang-format on
+
 void MainFrame::DataToControls()
 {
-    CalculateTotalTime();
     FillListControl();
+    UpdateTotalTime();
 }
 
 void MainFrame::OnClose(wxCloseEvent& event)
@@ -417,6 +601,27 @@ void MainFrame::OnResize(wxSizeEvent& event)
     event.Skip();
 }
 
+void MainFrame::OnBackupScheduleTimer(wxTimerEvent& WXUNUSED(event))
+{
+    if (!cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled() || IsDatabaseBackupRunning()) {
+        return;
+    }
+
+    /* the first backup of a session is due straight away, later ones once the interval has passed */
+    if (mLastBackupTime.IsValid()) {
+        auto sinceLastBackup = wxDateTime::Now().Subtract(mLastBackupTime);
+        if (sinceLastBackup.GetMinutes() < cfg::ConfigurationProvider::Get().Configuration->GetBackupInterval()) {
+            return;
+        }
+    }
+
+    if (!IsUserIdle()) {
+        return;
+    }
+
+    StartDatabaseBackup(false);
+}
+
 void MainFrame::OnDismissInfoBar(wxTimerEvent& event)
 {
     pDismissInfoBarTimer->Stop();
@@ -495,6 +700,12 @@ void MainFrame::OnWeeklyView(wxCommandEvent& event)
     weeklyTaskViewDialog->Show(true);
 }
 
+void MainFrame::OnAggregateView(wxCommandEvent& event)
+{
+    dlg::AggregateViewDialog* aggregateViewDialog = new dlg::AggregateViewDialog(this, pLogger);
+    aggregateViewDialog->Show(true);
+}
+
 //void MainFrame::OnMeetingsView(wxCommandEvent& event)
 //{
 //    dlg::MeetingsViewDialog* meetingViewDialog = new dlg::MeetingsViewDialog(this, pLogger);
@@ -566,12 +777,15 @@ void MainFrame::OnRestoreDatabase(wxCommandEvent& event)
 void MainFrame::OnBackupDatabase(wxCommandEvent& event)
 {
     if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled()) {
-        svc::DatabaseBackup databaseBackup(pLogger);
-        bool result = databaseBackup.Execute();
-        if (result) {
-            wxMessageBox(
-                wxT("Backup completed successfully!"), common::GetProgramName(), wxOK_DEFAULT | wxICON_INFORMATION);
-        } else {
+        if (IsDatabaseBackupRunning()) {
+            wxMessageBox(wxT("A database backup is already running."),
+                common::GetProgramName(),
+                wxOK_DEFAULT | wxICON_INFORMATION);
+            return;
+        }
+
+        /* the result is reported from OnBackupThreadCompletion */
+        if (!StartDatabaseBackup(true)) {
             wxMessageBox(wxT("Backup database operation encountered error(s)!"),
                 common::GetProgramName(),
                 wxOK_DEFAULT | wxICON_ERROR);
@@ -725,9 +939,8 @@ void MainFrame::OnPopupMenuDelete(wxCommandEvent& event)
 
     ShowInfoBarMessage(wxID_OK);
 
-    auto selectedDate = pDatePickerCtrl->GetValue();
-
-    CalculateTotalTime(selectedDate);
+    RemoveTaskItemDuration(mSelectedTaskItemId);
+    UpdateTotalTime();
 
     pListCtrl->DeleteItem(mItemIndex);
 
@@ -743,77 +956,76 @@ void MainFrame::OnColumnBeginDrag(wxListEvent& event)
     }
 }
 
-void MainFrame::OnTaskInserted(wxCommandEvent& event)
+void MainFrame::OnTaskInserted(dlg::TaskItemEvent& event)
 {
-    auto selectedDate = pDatePickerCtrl->GetValue();
-
-    CalculateTotalTime(selectedDate);
-
-    int id = event.GetId();
+    int id = event.GetTaskItemId();
+    if (id == -1) {
+        return;
+    }
 
-    data::TaskItemData taskItemData;
-    std::unique_ptr<model::TaskItemModel> taskItem;
-    if (id != -1) {
-        try {
-            taskItem = taskItemData.GetById(id);
-        } catch (const sqlite::sqlite_exception& e) {
-            pLogger->error("Error occured on TaskItemData::GetById() - {0:d} : {1}", e.get_code(), e.what());
-            return;
-        }
+    /* Tasks logged against another day (e.g. from the tray icon) do not belong in the current list */
+    if (event.GetTaskDate() != pDatePickerCtrl->GetValue().FormatISODate()) {
+        return;
+    }
 
-        int columnIndex = 0;
-        int listIndex = pListCtrl->InsertItem(columnIndex++, taskItem->GetProject()->GetDisplayName());
-        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetTask()->GetTaskDate());
-        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDuration());
-        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetCategory()->GetName());
-        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDescription());
+    long listIndex = pListCtrl->InsertItem(0, event.GetProjectName());
+    SetListItem(listIndex, event);
 
-        pListCtrl->SetItemBackgroundColour(listIndex, taskItem->GetCategory()->GetColor());
+    common::Duration duration = event.GetDuration();
+    mTaskItemDurations[id] = duration;
+    mTotalDuration += duration;
 
-        pListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
-    }
+    UpdateTotalTime();
 }
 
-void MainFrame::OnTaskUpdated(wxCommandEvent& event)
+void MainFrame::OnTaskUpdated(dlg::TaskItemEvent& event)
 {
-    auto selectedDate = pDatePickerCtrl->GetValue();
+    int id = event.GetTaskItemId();
 
-    CalculateTotalTime(selectedDate);
+    long listIndex = pListCtrl->FindItem(-1, static_cast<wxUIntPtr>(id));
 
-    int id = event.GetId();
+    /* The edit may have moved the task to another day, which takes it out of (or brings it into) the current list */
+    if (event.GetTaskDate() != pDatePickerCtrl->GetValue().FormatISODate()) {
+        if (listIndex != -1) {
+            pListCtrl->DeleteItem(listIndex);
+        }
 
-    data::TaskItemData taskItemData;
-    std::unique_ptr<model::TaskItemModel> taskItem;
-    try {
-        taskItem = taskItemData.GetById(id);
-    } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured on TaskItemData::GetById() - {0:d} : {1}", e.get_code(), e.what());
+        RemoveTaskItemDuration(id);
+        UpdateTotalTime();
+
+        mItemIndex = -1;
         return;
     }
 
-    int columnIndex = 0;
-    pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetProject()->GetDisplayName());
-    pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetTask()->GetTaskDate());
-    pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetDuration());
-    pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetCategory()->GetName());
-    pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetDescription());
+    if (listIndex == -1) {
+        listIndex = pListCtrl->InsertItem(0, event.GetProjectName());
+    }
 
-    pListCtrl->SetItemBackgroundColour(mItemIndex, taskItem->GetCategory()->GetColor());
+    SetListItem(listIndex, event);
+    pListCtrl->RefreshItem(listIndex);
 
-    pListCtrl->SetItemPtrData(mItemIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
+    RemoveTaskItemDuration(id);
 
-    pListCtrl->RefreshItem(mItemIndex);
+    common::Duration duration = event.GetDuration();
+    mTaskItemDurations[id] = duration;
+    mTotalDuration += duration;
+
+    UpdateTotalTime();
 
     mItemIndex = -1;
 }
 
-void MainFrame::OnTaskDeleted(wxCommandEvent& event)
+void MainFrame::OnTaskDeleted(dlg::TaskItemEvent& event)
 {
-    auto selectedDate = pDatePickerCtrl->GetValue();
+    int id = event.GetTaskItemId();
 
-    CalculateTotalTime(selectedDate);
+    long listIndex = pListCtrl->FindItem(-1, static_cast<wxUIntPtr>(id));
+    if (listIndex != -1) {
+        pListCtrl->DeleteItem(listIndex);
+    }
 
-    pListCtrl->DeleteItem(mItemIndex);
+    RemoveTaskItemDuration(id);
+    UpdateTotalTime();
 
     mItemIndex = -1;
 }
@@ -837,40 +1049,52 @@ void MainFrame::OnNewStopwatchTaskFromPausedStopwatchTask(wxCommandEvent& event)
     pListCtrl->SetFocus();
 }
 
-void MainFrame::CalculateTotalTime(wxDateTime date)
+void MainFrame::OnBackupThreadProgress(wxThreadEvent& event)
 {
-    auto dateString = date.FormatISODate();
+    SetStatusText(wxString::Format(wxT("Backing up database... %d%%"), event.GetInt()), 0);
+}
 
-    data::TaskItemData taskItemData;
-    std::vector<wxString> taskDurations;
-    try {
-        taskDurations = taskItemData.GetHours(dateString);
-    } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured on TaskItemData::GetHours() - {0:d} : {1}", e.get_code(), e.what());
-    }
+void MainFrame::OnBackupThreadCompletion(wxThreadEvent& event)
+{
+    bool result = event.GetInt() == 1;
+    SetStatusText(wxT("Ready"), 0);
 
-    wxTimeSpan totalDuration;
-    for (auto duration : taskDurations) {
-        std::vector<std::string> durationSplit = util::lib::split(duration.ToStdString(), ':');
+    /* a failed scheduled backup is retried after the next interval rather than every check */
+    mLastBackupTime = wxDateTime::Now();
 
-        wxTimeSpan currentDuration(std::atol(durationSplit[0].c_str()),
-            std::atol(durationSplit[1].c_str()),
-            (wxLongLong) std::atoll(durationSplit[2].c_str()));
+    if (!bManualBackup) {
+        if (!result) {
+            pInfoBar->ShowMessage(wxT("Scheduled database backup encountered error(s)!"), wxICON_ERROR);
+        }
+        return;
+    }
 
-        totalDuration += currentDuration;
+    if (result) {
+        wxMessageBox(
+            wxT("Backup completed successfully!"), common::GetProgramName(), wxOK_DEFAULT | wxICON_INFORMATION);
+    } else {
+        wxMessageBox(wxT("Backup database operation encountered error(s)!"),
+            common::GetProgramName(),
+            wxOK_DEFAULT | wxICON_ERROR);
     }
+}
 
-    pTotalHoursText->SetLabel(totalDuration.Format(constants::TotalHours));
+void MainFrame::UpdateTotalTime()
+{
+    pTotalHoursText->SetLabel(wxString::Format(constants::TotalHours, mTotalDuration.ToString()));
 }
 
 void MainFrame::FillListControl(wxDateTime date)
 {
-    wxString dateString = date.FormatISODate();
+    common::CivilDate taskDate = common::CivilDate::FromDateTime(date);
+
+    mTotalDuration = common::Duration();
+    mTaskItemDurations.clear();
 
     data::TaskItemData taskItemData;
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
     try {
-        taskItems = taskItemData.GetByDate(dateString);
+        taskItems = taskItemData.GetByDate(taskDate);
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured on TaskItemData::GetByDate() - {0:d} : {1}", e.get_code(), e.what());
         return;
@@ -881,7 +1105,7 @@ void MainFrame::FillListControl(wxDateTime date)
     for (const auto& taskItem : taskItems) {
         listIndex = pListCtrl->InsertItem(columnIndex++, taskItem->GetProject()->GetDisplayName());
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetTask()->GetTaskDate());
-        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDuration());
+        pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDuration().ToString());
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetCategory()->GetName());
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDescription());
 
@@ -889,20 +1113,124 @@ void MainFrame::FillListControl(wxDateTime date)
 
         pListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
 
+        common::Duration duration = taskItem->GetDuration();
+        mTaskItemDurations[taskItem->GetTaskItemId()] = duration;
+        mTotalDuration += duration;
+
         columnIndex = 0;
     }
 }
 
-bool MainFrame::RunDatabaseBackup()
+void MainFrame::SetListItem(long listIndex, const dlg::TaskItemEvent& event)
 {
-    if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled()) {
-        svc::DatabaseBackup dbBackup(pLogger);
-        return dbBackup.Execute();
+    int columnIndex = 0;
+    pListCtrl->SetItem(listIndex, columnIndex++, event.GetProjectName());
+    pListCtrl->SetItem(listIndex, columnIndex++, event.GetTaskDate());
+    pListCtrl->SetItem(listIndex, columnIndex++, event.GetDuration().ToString());
+    pListCtrl->SetItem(listIndex, columnIndex++, event.GetCategoryName());
+    pListCtrl->SetItem(listIndex, columnIndex++, event.GetDescription());
+
+    pListCtrl->SetItemBackgroundColour(listIndex, event.GetCategoryColor());
+
+    pListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(event.GetTaskItemId()));
+}
+
+void MainFrame::RemoveTaskItemDuration(int taskItemId)
+{
+    auto iterator = mTaskItemDurations.find(taskItemId);
+    if (iterator != mTaskItemDurations.end()) {
+        mTotalDuration -= iterator->second;
+        mTaskItemDurations.erase(iterator);
     }
+}
+
+bool MainFrame::StartDatabaseBackup(bool manual)
+{
+    wxCriticalSectionLocker enter(mBackupCriticalSection);
+    if (pBackupThread) {
+        return false;
+    }
+
+    pBackupThread = new DatabaseBackupThread(this, pLogger);
+    auto ret = pBackupThread->Run();
+    if (ret != wxTHREAD_NO_ERROR) {
+        delete pBackupThread;
+        pBackupThread = nullptr;
 
+        pLogger->error("Failed to start the database backup thread");
+        return false;
+    }
+
+    bManualBackup = manual;
+    SetStatusText(wxT("Backing up database..."), 0);
     return true;
 }
 
+bool MainFrame::IsDatabaseBackupRunning()
+{
+    wxCriticalSectionLocker enter(mBackupCriticalSection);
+    return pBackupThread != nullptr;
+}
+
+void MainFrame::BackupThreadCleanupProcedure()
+{
+    {
+        wxCriticalSectionLocker enter(mBackupCriticalSection);
+        if (pBackupThread) {
+            auto ret = pBackupThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                pLogger->error("Failed to stop the database backup thread");
+            }
+        }
+    }
+
+    while (1) {
+        {
+            wxCriticalSectionLocker enter(mBackupCriticalSection);
+            if (!pBackupThread) {
+                break;
+            }
+        }
+        wxThread::This()->Sleep(1);
+    }
+}
+
+void MainFrame::StartupThreadCleanupProcedure()
+{
+    {
+        wxCriticalSectionLocker enter(mStartupCriticalSection);
+        if (pStartupThread) {
+            auto ret = pStartupThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                pLogger->error("Failed to stop the startup tasks thread");
+            }
+        }
+    }
+
+    while (1) {
+        {
+            wxCriticalSectionLocker enter(mStartupCriticalSection);
+            if (!pStartupThread) {
+                break;
+            }
+        }
+        wxThread::This()->Sleep(1);
+    }
+}
+
+bool MainFrame::IsUserIdle() const
+{
+    LASTINPUTINFO lastInputInfo;
+    lastInputInfo.cbSize = sizeof(LASTINPUTINFO);
+    if (!::GetLastInputInfo(&lastInputInfo)) {
+        return true;
+    }
+
+    /* both are tick counts, so the unsigned subtraction is correct across the 49 day wrap around */
+    unsigned long idleMilliseconds = ::GetTickCount() - lastInputInfo.dwTime;
+    return idleMilliseconds >= BackupIdleThreshold;
+}
+
 void MainFrame::ShowInfoBarMessage(int modalRetCode)
 {
     if (modalRetCode == wxID_OK) {
@@ -921,8 +1249,8 @@ void MainFrame::DateChangedProcedure(wxDateTime dateTime)
     pListCtrl->DeleteAllItems();
     pDatePickerCtrl->SetValue(dateTime);
 
-    CalculateTotalTime(dateTime);
     FillListControl(dateTime);
+    UpdateTotalTime();
 
     pListCtrl->SetFocus();
 }
@@ -942,4 +1270,30 @@ void MainFrame::CopyToClipboardProcedure(long itemIndex)
         wxTheClipboard->Close();
     }
 }
+
+void MainFrame::OnConfigFileChanged(wxFileSystemWatcherEvent& event)
+{
+    /* editors (and our own saves) replace the file through a rename, so the new name is matched as well */
+    wxFileName configFileName(common::GetConfigFilePath());
+    if (event.GetPath() != configFileName && event.GetNewPath() != configFileName) {
+        return;
+    }
+
+    /* our own writes parse back to the current settings, so only external edits get this far */
+    std::string error;
+    if (!cfg::ConfigurationProvider::Get().Configuration->Reload(error)) {
+        if (!error.empty()) {
+            pLogger->warn("Ignored the changes to {0} - {1}", configFileName.GetFullPath().ToStdString(), error);
+        }
+        return;
+    }
+
+    pLogger->info("Reloaded the configuration after {0} was changed", configFileName.GetFullPath().ToStdString());
+
+    if (cfg::ConfigurationProvider::Get().Configuration->IsShowInTray() && !pTaskBarIcon->IsIconInstalled()) {
+        pTaskBarIcon->SetTaskBarIcon();
+    } else if (!cfg::ConfigurationProvider::Get().Configuration->IsShowInTray() && pTaskBarIcon->IsIconInstalled()) {
+        pTaskBarIcon->RemoveIcon();
+    }
+}
 } // namespace app::frm
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include <sqlite_modern_cpp.h>
 
@@ -28,20 +29,58 @@
 #include <wx/bmpbuttn.h>
 #include <wx/datectrl.h>
 #include <wx/dateevt.h>
+#include <wx/fswatcher.h>
 #include <wx/infobar.h>
 #include <wx/listctrl.h>
+#include <wx/thread.h>
 #include <wx/timer.h>
 
 #include <spdlog/spdlog.h>
 
+#include "../common/duration.h"
 #include "../config/configurationprovider.h"
 #include "../services/taskstateservice.h"
 #include "../services/taskstorageservice.h"
+#include "../dialogs/taskitemdlg.h"
 #include "feedbackpopup.h"
 
+wxDECLARE_EVENT(DATABASE_BACKUP_THREAD_PROGRESS, wxThreadEvent);
+wxDECLARE_EVENT(DATABASE_BACKUP_THREAD_COMPLETED, wxThreadEvent);
+
 namespace app::frm
 {
 class TaskBarIcon;
+class MainFrame;
+
+class DatabaseBackupThread final : public wxThread
+{
+public:
+    DatabaseBackupThread() = delete;
+    DatabaseBackupThread(MainFrame* handler, std::shared_ptr<spdlog::logger> logger);
+    virtual ~DatabaseBackupThread();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    MainFrame* pHandler;
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+
+class StartupTasksThread final : public wxThread
+{
+public:
+    StartupTasksThread() = delete;
+    StartupTasksThread(MainFrame* handler, std::shared_ptr<spdlog::logger> logger);
+    virtual ~StartupTasksThread();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    MainFrame* pHandler;
+    std::shared_ptr<spdlog::logger> pLogger;
+};
 
 class MainFrame : public wxFrame
 {
@@ -54,6 +93,17 @@ class MainFrame : public wxFrame
     MainFrame& operator=(const MainFrame&) = delete;
 
     bool CreateFrame();
+    /* Startup splits around the first paint, the day's task items load right after it and the rest in the background */
+    void LoadStartupData();
+    void StartBackgroundStartupTasks();
+    /* Picks up edits made to taskable.toml outside the application */
+    void WatchConfigFile();
+
+protected:
+    DatabaseBackupThread* pBackupThread;
+    wxCriticalSection mBackupCriticalSection;
+    StartupTasksThread* pStartupThread;
+    wxCriticalSection mStartupCriticalSection;
 
 private:
     wxDECLARE_EVENT_TABLE();
@@ -61,6 +111,7 @@ class MainFrame : public wxFrame
     bool Create();
 
     void CreateControls();
+    void ConfigureEventBindings();
     void DataToControls();
 
     /* General Event Handlers */
@@ -68,6 +119,7 @@ class MainFrame : public wxFrame
     void OnIconize(wxIconizeEvent& event);
     void OnResize(wxSizeEvent& event);
     void OnDismissInfoBar(wxTimerEvent& event);
+    void OnBackupScheduleTimer(wxTimerEvent& event);
 
     /* Main Menu Event Handlers */
     void OnAbout(wxCommandEvent& event);
@@ -79,6 +131,7 @@ class MainFrame : public wxFrame
     void OnNewProject(wxCommandEvent& event);
     void OnNewCategory(wxCommandEvent& event);
     void OnWeeklyView(wxCommandEvent& event);
+    void OnAggregateView(wxCommandEvent& event);
     //void OnMeetingsView(wxCommandEvent& event);
     void OnEditEmployer(wxCommandEvent& event);
     void OnEditClient(wxCommandEvent& event);
@@ -108,15 +161,25 @@ class MainFrame : public wxFrame
     void OnColumnBeginDrag(wxListEvent& event);
 
     /* Uncategorized Event Handlers */
-    void OnTaskInserted(wxCommandEvent& event);
-    void OnTaskUpdated(wxCommandEvent& event);
-    void OnTaskDeleted(wxCommandEvent& event);
+    void OnTaskInserted(dlg::TaskItemEvent& event);
+    void OnTaskUpdated(dlg::TaskItemEvent& event);
+    void OnTaskDeleted(dlg::TaskItemEvent& event);
     void OnNewStopwatchTaskFromPausedStopwatchTask(wxCommandEvent& event);
+    void OnBackupThreadProgress(wxThreadEvent& event);
+    void OnBackupThreadCompletion(wxThreadEvent& event);
+    void OnConfigFileChanged(wxFileSystemWatcherEvent& event);
 
-    void CalculateTotalTime(wxDateTime date = wxDateTime::Now());
+    void UpdateTotalTime();
     void FillListControl(wxDateTime date = wxDateTime::Now());
 
-    bool RunDatabaseBackup();
+    void SetListItem(long listIndex, const dlg::TaskItemEvent& event);
+    void RemoveTaskItemDuration(int taskItemId);
+
+    bool StartDatabaseBackup(bool manual);
+    bool IsDatabaseBackupRunning();
+    void BackupThreadCleanupProcedure();
+    void StartupThreadCleanupProcedure();
+    bool IsUserIdle() const;
 
     void ShowInfoBarMessage(int modalRetCode);
 
@@ -128,6 +191,8 @@ class MainFrame : public wxFrame
     std::unique_ptr<services::TaskStorage> pTaskStorage;
 
     std::unique_ptr<wxTimer> pDismissInfoBarTimer;
+    std::unique_ptr<wxTimer> pBackupScheduleTimer;
+    std::unique_ptr<wxFileSystemWatcher> pConfigWatcher;
 
     wxButton* pPrevDayBtn;
     wxDatePickerCtrl* pDatePickerCtrl;
@@ -144,6 +209,20 @@ class MainFrame : public wxFrame
     long mItemIndex;
     int mSelectedTaskItemId;
 
+    /* Running totals for the selected day, kept in step with the task item events */
+    common::Duration mTotalDuration;
+    std::unordered_map<int, common::Duration> mTaskItemDurations;
+
+    /* Scheduled backups run on a worker thread once the interval has passed and the user is away */
+    wxDateTime mLastBackupTime;
+    bool bManualBackup;
+
+    static constexpr int BackupScheduleCheckInterval = 60 * 1000;
+    static constexpr unsigned long BackupIdleThreshold = 2 * 60 * 1000;
+
+    friend class DatabaseBackupThread;
+    friend class StartupTasksThread;
+
     enum {
         IDC_PREV_DAY = wxID_HIGHEST + 1,
         IDC_GO_TO_DATE,
@@ -151,7 +230,8 @@ class MainFrame : public wxFrame
         IDC_HOURS_TEXT,
         IDC_LIST,
         IDC_FEEDBACK,
-        IDC_DISMISS_INFOBAR_TIMER
+        IDC_DISMISS_INFOBAR_TIMER,
+        IDC_BACKUP_SCHEDULE_TIMER
     };
 };
 } // namespace app::frm
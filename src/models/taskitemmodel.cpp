@@ -30,7 +30,7 @@ TaskItemModel::TaskItemModel()
     : mTaskItemId(-1)
     , pStartTime(nullptr)
     , pEndTime(nullptr)
-    , mDuration(wxGetEmptyString())
+    , mDuration()
     , mDescription(wxGetEmptyString())
     , mDateCreated(wxDefaultDateTime)
     , mDateModified(wxDefaultDateTime)
@@ -55,7 +55,7 @@ TaskItemModel::TaskItemModel(int taskItemId)
 }
 
 TaskItemModel::TaskItemModel(int taskItemId,
-    wxString duration,
+    common::Duration duration,
     wxString description,
     int dateCreated,
     int dateModified,
@@ -97,12 +97,7 @@ const wxDateTime* TaskItemModel::GetEndTime() const
     return pEndTime.get();
 }
 
-const wxDateTime* TaskItemModel::GetDurationTime() const
-{
-    return pDurationTime.get();
-}
-
-const wxString TaskItemModel::GetDuration() const
+const common::Duration TaskItemModel::GetDuration() const
 {
     return mDuration;
 }
@@ -192,11 +187,6 @@ void TaskItemModel::SetEndTime(std::unique_ptr<wxDateTime> endTime)
     pEndTime = std::move(endTime);
 }
 
-void TaskItemModel::SetDurationTime(std::unique_ptr<wxDateTime> durationTime)
-{
-    pDurationTime = std::move(durationTime);
-}
-
 void TaskItemModel::SetStartTime(const wxString& startTime)
 {
     wxDateTime startDateTime;
@@ -211,14 +201,7 @@ void TaskItemModel::SetEndTime(const wxString& endTime)
     pEndTime = std::make_unique<wxDateTime>(endDateTime);
 }
 
-void TaskItemModel::SetDurationTime(const wxString& durationTime)
-{
-    wxDateTime durationDateTime;
-    durationDateTime.ParseISOTime(durationTime);
-    pDurationTime = std::make_unique<wxDateTime>(durationDateTime);
-}
-
-void TaskItemModel::SetDuration(const wxString& duration)
+void TaskItemModel::SetDuration(common::Duration duration)
 {
     mDuration = duration;
 }
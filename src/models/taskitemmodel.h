@@ -24,6 +24,7 @@
 #include <wx/datetime.h>
 
 #include "../common/constants.h"
+#include "../common/duration.h"
 #include "projectmodel.h"
 #include "categorymodel.h"
 #include "taskmodel.h"
@@ -38,7 +39,7 @@ class TaskItemModel final
     TaskItemModel();
     TaskItemModel(int taskItemId);
     TaskItemModel(int taskItemId,
-        wxString duration,
+        common::Duration duration,
         wxString description,
         int dateCreated,
         int dateModified,
@@ -51,8 +52,7 @@ class TaskItemModel final
     const int GetTaskItemId() const;
     const wxDateTime* GetStartTime() const;
     const wxDateTime* GetEndTime() const;
-    const wxDateTime* GetDurationTime() const;
-    const wxString GetDuration() const;
+    const common::Duration GetDuration() const;
     const wxString GetDescription() const;
     const wxDateTime GetDateCreated();
     const wxDateTime GetDateModified();
@@ -73,11 +73,9 @@ class TaskItemModel final
     void SetTaskItemId(const int taskItemId);
     void SetStartTime(std::unique_ptr<wxDateTime> startTime);
     void SetEndTime(std::unique_ptr<wxDateTime> endTime);
-    void SetDurationTime(std::unique_ptr<wxDateTime> durationTime);
     void SetStartTime(const wxString& startTime);
     void SetEndTime(const wxString& endTime);
-    void SetDurationTime(const wxString& durationTime);
-    void SetDuration(const wxString& duration);
+    void SetDuration(common::Duration duration);
     void SetDescription(const wxString& description);
     void SetDateCreated(const wxDateTime& dateCreated);
     void SetDateUpdated(const wxDateTime& dateModified);
@@ -99,8 +97,7 @@ class TaskItemModel final
     int mTaskItemId;
     std::unique_ptr<wxDateTime> pStartTime;
     std::unique_ptr<wxDateTime> pEndTime;
-    std::unique_ptr<wxDateTime> pDurationTime;
-    wxString mDuration;
+    common::Duration mDuration;
     wxString mDescription;
     wxDateTime mDateCreated;
     wxDateTime mDateModified;
@@ -0,0 +1,282 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupcatalog.h"
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <system_error>
+
+#include "../common/sha256.h"
+
+namespace app::svc
+{
+std::mutex BackupCatalog::CatalogMutex;
+
+BackupCatalog::BackupCatalog(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath)
+    : pLogger(logger)
+    , mBackupPath(backupPath)
+    , mCatalogFilePath((std::filesystem::path(backupPath) / FileName).string())
+{
+}
+
+std::vector<BackupCatalogEntry> BackupCatalog::GetEntries()
+{
+    std::lock_guard<std::mutex> lock(CatalogMutex);
+
+    std::vector<BackupCatalogEntry> entries;
+    if (!Load(entries)) {
+        return std::vector<BackupCatalogEntry>();
+    }
+    return entries;
+}
+
+bool BackupCatalog::Record(const std::string& filePath,
+    std::int64_t timestamp,
+    const std::string& schemaVersion,
+    BackupVerification verification)
+{
+    BackupCatalogEntry entry;
+    if (!Describe(filePath, entry)) {
+        return false;
+    }
+    entry.Timestamp = timestamp;
+    entry.SchemaVersion = schemaVersion;
+    entry.Verification = verification;
+
+    std::lock_guard<std::mutex> lock(CatalogMutex);
+
+    std::vector<BackupCatalogEntry> entries;
+    if (!Load(entries)) {
+        return false;
+    }
+
+    entries.erase(std::remove_if(entries.begin(),
+                      entries.end(),
+                      [&](const BackupCatalogEntry& existing) { return existing.FileName == entry.FileName; }),
+        entries.end());
+    entries.push_back(entry);
+
+    return Save(entries);
+}
+
+bool BackupCatalog::Remove(const std::vector<std::string>& fileNames)
+{
+    std::lock_guard<std::mutex> lock(CatalogMutex);
+
+    std::vector<BackupCatalogEntry> entries;
+    if (!Load(entries)) {
+        return false;
+    }
+
+    entries.erase(std::remove_if(entries.begin(),
+                      entries.end(),
+                      [&](const BackupCatalogEntry& entry) {
+                          return std::find(fileNames.begin(), fileNames.end(), entry.FileName) != fileNames.end();
+                      }),
+        entries.end());
+
+    return Save(entries);
+}
+
+bool BackupCatalog::Load(std::vector<BackupCatalogEntry>& entries)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(mCatalogFilePath, error)) {
+        return Import(entries) && Save(entries);
+    }
+
+    std::ifstream catalogFile(mCatalogFilePath);
+    std::string line;
+    if (!std::getline(catalogFile, line) || line != CatalogHeader) {
+        pLogger->error("Backup catalog {0} is not readable", mCatalogFilePath);
+        return false;
+    }
+
+    while (std::getline(catalogFile, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string timestamp;
+        std::string size;
+        std::string verification;
+
+        BackupCatalogEntry entry;
+        if (!std::getline(fields, entry.FileName, '\t') || !std::getline(fields, timestamp, '\t') ||
+            !std::getline(fields, size, '\t') || !std::getline(fields, entry.Checksum, '\t') ||
+            !std::getline(fields, entry.SchemaVersion, '\t')) {
+            pLogger->warn("Skipping malformed backup catalog entry \"{0}\"", line);
+            continue;
+        }
+
+        /* entries written before backups were verified have no verification field */
+        if (std::getline(fields, verification, '\t')) {
+            entry.Verification = ParseVerification(verification);
+        }
+
+        try {
+            entry.Timestamp = std::stoll(timestamp);
+            entry.Size = std::stoull(size);
+        } catch (const std::exception&) {
+            pLogger->warn("Skipping malformed backup catalog entry \"{0}\"", line);
+            continue;
+        }
+
+        entries.push_back(entry);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const BackupCatalogEntry& lhs, const BackupCatalogEntry& rhs) {
+        return lhs.Timestamp < rhs.Timestamp;
+    });
+
+    return true;
+}
+
+bool BackupCatalog::Save(const std::vector<BackupCatalogEntry>& entries)
+{
+    std::string temporaryFilePath = mCatalogFilePath + ".tmp";
+    {
+        std::ofstream catalogFile(temporaryFilePath, std::ios_base::out | std::ios_base::trunc);
+        catalogFile << CatalogHeader << '\n';
+        for (const auto& entry : entries) {
+            catalogFile << entry.FileName << '\t' << entry.Timestamp << '\t' << entry.Size << '\t' << entry.Checksum
+                        << '\t' << entry.SchemaVersion << '\t' << ToString(entry.Verification) << '\n';
+        }
+
+        catalogFile.close();
+        if (!catalogFile) {
+            pLogger->error("Failed to write backup catalog {0}", temporaryFilePath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryFilePath, mCatalogFilePath, error);
+    if (error) {
+        pLogger->error("Failed to move backup catalog {0} into place - {1}", mCatalogFilePath, error.message());
+        std::filesystem::remove(temporaryFilePath, error);
+        return false;
+    }
+
+    return true;
+}
+
+bool BackupCatalog::Import(std::vector<BackupCatalogEntry>& entries)
+{
+    /* backups taken before the catalog existed only carry the day they were taken in their file name */
+    const std::regex dateRegex("([0-9]{4})-([0-9]{2})-([0-9]{2})");
+
+    std::error_code error;
+    for (const auto& directoryEntry : std::filesystem::directory_iterator(mBackupPath, error)) {
+        auto fileName = directoryEntry.path().filename().string();
+        std::smatch dateMatch;
+        if (!directoryEntry.is_regular_file() || directoryEntry.path().extension() == ".tmp" ||
+            !std::regex_search(fileName, dateMatch, dateRegex)) {
+            continue;
+        }
+
+        BackupCatalogEntry entry;
+        if (!Describe(directoryEntry.path().string(), entry)) {
+            continue;
+        }
+
+        std::tm date = {};
+        date.tm_year = std::stoi(dateMatch[1]) - 1900;
+        date.tm_mon = std::stoi(dateMatch[2]) - 1;
+        date.tm_mday = std::stoi(dateMatch[3]);
+        date.tm_isdst = -1;
+        entry.Timestamp = static_cast<std::int64_t>(std::mktime(&date));
+        entry.SchemaVersion = UnknownSchemaVersion;
+
+        entries.push_back(entry);
+    }
+    if (error) {
+        pLogger->error("Failed to list backups in {0} - {1}", mBackupPath, error.message());
+        return false;
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const BackupCatalogEntry& lhs, const BackupCatalogEntry& rhs) {
+        return lhs.Timestamp < rhs.Timestamp;
+    });
+
+    pLogger->info("Created backup catalog {0} with {1:d} existing backups", mCatalogFilePath, entries.size());
+    return true;
+}
+
+bool BackupCatalog::Describe(const std::string& filePath, BackupCatalogEntry& entry)
+{
+    std::ifstream backupFile(filePath, std::ios_base::in | std::ios_base::binary);
+    if (!backupFile) {
+        pLogger->error("Failed to open backup {0}", filePath);
+        return false;
+    }
+
+    common::Sha256 checksum;
+    std::vector<char> buffer(1 << 16);
+    while (backupFile) {
+        backupFile.read(buffer.data(), buffer.size());
+        auto bytesRead = static_cast<std::size_t>(backupFile.gcount());
+        checksum.Update(buffer.data(), bytesRead);
+        entry.Size += bytesRead;
+    }
+
+    if (backupFile.bad()) {
+        pLogger->error("Failed to read backup {0}", filePath);
+        return false;
+    }
+
+    entry.FileName = std::filesystem::path(filePath).filename().string();
+    entry.Checksum = common::Sha256::ToHex(checksum.Finalize());
+    return true;
+}
+
+const char* BackupCatalog::ToString(BackupVerification verification)
+{
+    switch (verification) {
+    case BackupVerification::QuickCheckPassed:
+        return "quick_check";
+    case BackupVerification::IntegrityCheckPassed:
+        return "integrity_check";
+    case BackupVerification::Failed:
+        return "failed";
+    default:
+        return "unverified";
+    }
+}
+
+BackupVerification BackupCatalog::ParseVerification(const std::string& value)
+{
+    if (value == "quick_check") {
+        return BackupVerification::QuickCheckPassed;
+    }
+    if (value == "integrity_check") {
+        return BackupVerification::IntegrityCheckPassed;
+    }
+    if (value == "failed") {
+        return BackupVerification::Failed;
+    }
+    return BackupVerification::Unverified;
+}
+} // namespace app::svc
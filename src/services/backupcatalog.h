@@ -0,0 +1,98 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace app::svc
+{
+enum class BackupVerification {
+    Unverified,
+    QuickCheckPassed,
+    IntegrityCheckPassed,
+    Failed,
+};
+
+struct BackupCatalogEntry {
+    std::string FileName;
+    /* seconds since the epoch when the backup was taken */
+    std::int64_t Timestamp = 0;
+    std::uint64_t Size = 0;
+    /* SHA-256 of the file as stored, so of the archive or manifest for compressed and incremental backups */
+    std::string Checksum;
+    std::string SchemaVersion;
+    BackupVerification Verification = BackupVerification::Unverified;
+
+    bool IsVerified() const
+    {
+        return Verification == BackupVerification::QuickCheckPassed ||
+               Verification == BackupVerification::IntegrityCheckPassed;
+    }
+};
+
+/*
+ * An index of the backups in the backup directory, kept in a sidecar file next to them.
+ * Retention and the restore wizard read it instead of listing the directory and parsing dates out of file names.
+ * Every operation loads, changes and saves the file under one lock, since the backup thread and the UI thread
+ * both use it.
+ */
+class BackupCatalog final
+{
+public:
+    static constexpr const char* FileName = "backups.catalog";
+
+    BackupCatalog() = delete;
+    BackupCatalog(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath);
+    ~BackupCatalog() = default;
+
+    /* Ordered oldest first. A missing catalog is built once from the backups already in the directory */
+    std::vector<BackupCatalogEntry> GetEntries();
+    /* Replaces any entry with the same file name, as a second backup on the same day overwrites the first */
+    bool Record(const std::string& filePath,
+        std::int64_t timestamp,
+        const std::string& schemaVersion,
+        BackupVerification verification);
+    bool Remove(const std::vector<std::string>& fileNames);
+
+private:
+    bool Load(std::vector<BackupCatalogEntry>& entries);
+    bool Save(const std::vector<BackupCatalogEntry>& entries);
+    bool Import(std::vector<BackupCatalogEntry>& entries);
+    bool Describe(const std::string& filePath, BackupCatalogEntry& entry);
+
+    static const char* ToString(BackupVerification verification);
+    static BackupVerification ParseVerification(const std::string& value);
+
+    static constexpr const char* CatalogHeader = "taskable-backup-catalog 1";
+    static constexpr const char* UnknownSchemaVersion = "unknown";
+
+    static std::mutex CatalogMutex;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::string mBackupPath;
+    std::string mCatalogFilePath;
+};
+} // namespace app::svc
@@ -0,0 +1,160 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupcompressor.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include <zlib.h>
+
+#include "bufferedfilewriter.h"
+
+namespace app::svc
+{
+BackupCompressor::BackupCompressor(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+bool BackupCompressor::Compress(const std::string& sourceFilePath,
+    const std::string& destinationFilePath,
+    int compressionLevel)
+{
+    std::ifstream sourceFile(sourceFilePath, std::ios_base::in | std::ios_base::binary);
+    if (!sourceFile) {
+        pLogger->error("Failed to open {0} for compression", sourceFilePath);
+        return false;
+    }
+
+    BufferedFileWriter archiveFile(destinationFilePath);
+    if (!archiveFile.OpenCompressed(compressionLevel)) {
+        pLogger->error("Failed to create archive {0}", destinationFilePath);
+        return false;
+    }
+
+    auto chunk = std::make_unique<char[]>(ChunkSize);
+    while (sourceFile) {
+        sourceFile.read(chunk.get(), ChunkSize);
+        auto bytesRead = static_cast<std::size_t>(sourceFile.gcount());
+        if (bytesRead > 0) {
+            archiveFile.Write(chunk.get(), bytesRead);
+        }
+    }
+
+    bool readFailed = sourceFile.bad();
+    if (!archiveFile.Close() || readFailed) {
+        pLogger->error("Failed to compress {0} to {1}", sourceFilePath, destinationFilePath);
+        std::remove(destinationFilePath.c_str());
+        return false;
+    }
+
+    pLogger->info("Compressed {0} ({1:d} bytes) to {2} ({3:d} bytes)",
+        sourceFilePath,
+        archiveFile.GetBytesWritten(),
+        destinationFilePath,
+        archiveFile.GetFileBytesWritten());
+    return true;
+}
+
+bool BackupCompressor::Decompress(const std::string& sourceFilePath, const std::string& destinationFilePath)
+{
+    std::ifstream archiveFile(sourceFilePath, std::ios_base::in | std::ios_base::binary);
+    if (!archiveFile) {
+        pLogger->error("Failed to open archive {0}", sourceFilePath);
+        return false;
+    }
+
+    std::ofstream destinationFile(destinationFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!destinationFile) {
+        pLogger->error("Failed to create {0}", destinationFilePath);
+        return false;
+    }
+
+    z_stream stream = {};
+    /* 32 added to the window bits lets inflate read the gzip header */
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        pLogger->error("Failed to initialize zlib to decompress {0}", sourceFilePath);
+        return false;
+    }
+
+    auto input = std::make_unique<char[]>(ChunkSize);
+    auto output = std::make_unique<char[]>(ChunkSize);
+
+    int rc = Z_OK;
+    bool succeeded = true;
+    while (succeeded) {
+        archiveFile.read(input.get(), ChunkSize);
+        stream.avail_in = static_cast<uInt>(archiveFile.gcount());
+        stream.next_in = reinterpret_cast<Bytef*>(input.get());
+        if (stream.avail_in == 0) {
+            break;
+        }
+
+        do {
+            /* gzip members may be concatenated, each one is inflated in turn */
+            if (rc == Z_STREAM_END) {
+                inflateReset(&stream);
+            }
+
+            stream.avail_out = static_cast<uInt>(ChunkSize);
+            stream.next_out = reinterpret_cast<Bytef*>(output.get());
+
+            rc = inflate(&stream, Z_NO_FLUSH);
+            if (rc == Z_BUF_ERROR && stream.avail_in == 0) {
+                /* the output was drained exactly at the end of this chunk */
+                rc = Z_OK;
+                break;
+            }
+            if (rc != Z_OK && rc != Z_STREAM_END) {
+                pLogger->error("Failed to decompress {0} - {1:d} : {2}", sourceFilePath, rc, stream.msg ? stream.msg : "");
+                succeeded = false;
+                break;
+            }
+
+            destinationFile.write(output.get(), static_cast<std::streamsize>(ChunkSize - stream.avail_out));
+        } while (stream.avail_in > 0 || (stream.avail_out == 0 && rc != Z_STREAM_END));
+    }
+
+    inflateEnd(&stream);
+
+    if (succeeded && rc != Z_STREAM_END) {
+        pLogger->error("Archive {0} is truncated", sourceFilePath);
+        succeeded = false;
+    }
+
+    destinationFile.close();
+    if (!destinationFile || archiveFile.bad()) {
+        pLogger->error("Failed to write {0}", destinationFilePath);
+        succeeded = false;
+    }
+
+    if (!succeeded) {
+        std::remove(destinationFilePath.c_str());
+    }
+    return succeeded;
+}
+
+bool BackupCompressor::IsCompressed(const std::string& filePath)
+{
+    const std::string extension = Extension;
+    return filePath.size() > extension.size() &&
+           filePath.compare(filePath.size() - extension.size(), extension.size(), extension) == 0;
+}
+} // namespace app::svc
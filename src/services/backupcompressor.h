@@ -0,0 +1,54 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace app::svc
+{
+/*
+ * Streams a database file to and from a gzip archive in fixed size chunks, so memory use does not grow with the
+ * size of the database. Archives are ordinary .gz files and can also be opened with any gzip tool.
+ */
+class BackupCompressor final
+{
+public:
+    BackupCompressor() = delete;
+    BackupCompressor(std::shared_ptr<spdlog::logger> logger);
+    ~BackupCompressor() = default;
+
+    bool Compress(const std::string& sourceFilePath, const std::string& destinationFilePath, int compressionLevel);
+    /* The destination is removed again if the archive is truncated or damaged */
+    bool Decompress(const std::string& sourceFilePath, const std::string& destinationFilePath);
+
+    static bool IsCompressed(const std::string& filePath);
+
+    static constexpr const char* Extension = ".gz";
+
+private:
+    static constexpr std::size_t ChunkSize = 1 << 16;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
@@ -0,0 +1,123 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupdirectorylock.h"
+
+#include <filesystem>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace app::svc
+{
+BackupDirectoryLock::BackupDirectoryLock(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath)
+    : pLogger(logger)
+    , mLockFilePath((std::filesystem::path(backupPath) / LockFileName).string())
+#ifdef _WIN32
+    , pHandle(INVALID_HANDLE_VALUE)
+#else
+    , mDescriptor(-1)
+#endif
+{
+}
+
+BackupDirectoryLock::~BackupDirectoryLock()
+{
+    Release();
+}
+
+bool BackupDirectoryLock::Acquire(std::chrono::milliseconds timeout, std::function<bool()> cancelled)
+{
+    constexpr auto RetryInterval = std::chrono::milliseconds(100);
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!TryAcquire()) {
+        if (std::chrono::steady_clock::now() >= deadline || (cancelled && cancelled())) {
+            pLogger->warn("Backup directory is in use, could not lock {0}", mLockFilePath);
+            return false;
+        }
+        std::this_thread::sleep_for(RetryInterval);
+    }
+
+    return true;
+}
+
+void BackupDirectoryLock::Release()
+{
+#ifdef _WIN32
+    if (pHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(pHandle);
+        pHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (mDescriptor != -1) {
+        flock(mDescriptor, LOCK_UN);
+        close(mDescriptor);
+        mDescriptor = -1;
+    }
+#endif
+}
+
+bool BackupDirectoryLock::IsAcquired() const
+{
+#ifdef _WIN32
+    return pHandle != INVALID_HANDLE_VALUE;
+#else
+    return mDescriptor != -1;
+#endif
+}
+
+bool BackupDirectoryLock::TryAcquire()
+{
+    if (IsAcquired()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    /* no share mode, so every other open of the file fails with a sharing violation while this handle is open */
+    auto path = std::filesystem::path(mLockFilePath).wstring();
+    pHandle = CreateFileW(path.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        0,
+        nullptr,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    return pHandle != INVALID_HANDLE_VALUE;
+#else
+    /* flock locks belong to the open file description, so separate opens in one process exclude each other too */
+    mDescriptor = open(mLockFilePath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mDescriptor == -1) {
+        return false;
+    }
+    if (flock(mDescriptor, LOCK_EX | LOCK_NB) != 0) {
+        close(mDescriptor);
+        mDescriptor = -1;
+        return false;
+    }
+    return true;
+#endif
+}
+} // namespace app::svc
@@ -0,0 +1,65 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace app::svc
+{
+/*
+ * An exclusive lock on a lock file in the backup directory, held while a backup, retention or an incremental restore
+ * works in it. The file is opened without sharing, so a second thread or a second process (the command line
+ * --backup next to the running application) fails to take it until the first lets go, and the operating system
+ * drops the lock with the process if it exits without releasing it.
+ */
+class BackupDirectoryLock final
+{
+public:
+    static constexpr const char* LockFileName = "taskable-backup.lock";
+
+    BackupDirectoryLock() = delete;
+    BackupDirectoryLock(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath);
+    BackupDirectoryLock(const BackupDirectoryLock&) = delete;
+    BackupDirectoryLock& operator=(const BackupDirectoryLock&) = delete;
+    ~BackupDirectoryLock();
+
+    /* Retries until the timeout runs out, giving up early once the cancelled callback returns true */
+    bool Acquire(std::chrono::milliseconds timeout, std::function<bool()> cancelled = nullptr);
+    void Release();
+
+    bool IsAcquired() const;
+
+private:
+    bool TryAcquire();
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::string mLockFilePath;
+#ifdef _WIN32
+    void* pHandle;
+#else
+    int mDescriptor;
+#endif
+};
+} // namespace app::svc
@@ -0,0 +1,96 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupretentionpolicy.h"
+
+#include <ctime>
+
+#include "../common/civildate.h"
+
+namespace app::svc
+{
+BackupRetentionPolicy::BackupRetentionPolicy(const BackupRetentionRules& rules)
+    : mRules(rules)
+{
+}
+
+bool BackupRetentionPolicy::IsEnabled() const
+{
+    return mRules.KeepDaily > 0 || mRules.KeepWeekly > 0 || mRules.KeepMonthly > 0;
+}
+
+std::vector<std::string> BackupRetentionPolicy::SelectForDeletion(const std::vector<BackupCatalogEntry>& entries) const
+{
+    std::vector<std::string> filesToDelete;
+    if (!IsEnabled() || entries.empty()) {
+        return filesToDelete;
+    }
+
+    int keptDays = 0;
+    int keptWeeks = 0;
+    int keptMonths = 0;
+    int lastDay = 0;
+    int lastWeek = 0;
+    int lastMonth = 0;
+
+    for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+        /* a backup that failed verification cannot be restored, so it must not hold a slot a good backup would fill */
+        if (entry->Verification == BackupVerification::Failed) {
+            if (entry != entries.rbegin()) {
+                filesToDelete.push_back(entry->FileName);
+            }
+            continue;
+        }
+
+        auto timestamp = static_cast<std::time_t>(entry->Timestamp);
+        std::tm localTime = {};
+        localtime_s(&localTime, &timestamp);
+
+        auto date =
+            common::CivilDate::FromYearMonthDay(localTime.tm_year + 1900, localTime.tm_mon + 1, localTime.tm_mday);
+        int day = date.GetDaysSinceEpoch();
+        int week = date.GetMonday().GetDaysSinceEpoch();
+        int month = (localTime.tm_year + 1900) * 12 + localTime.tm_mon;
+
+        /* the first backup seen of a day, week or month is its newest, and each period counts once */
+        bool keep = entry == entries.rbegin();
+        if (keptDays < mRules.KeepDaily && (keptDays == 0 || day != lastDay)) {
+            keptDays++;
+            lastDay = day;
+            keep = true;
+        }
+        if (keptWeeks < mRules.KeepWeekly && (keptWeeks == 0 || week != lastWeek)) {
+            keptWeeks++;
+            lastWeek = week;
+            keep = true;
+        }
+        if (keptMonths < mRules.KeepMonthly && (keptMonths == 0 || month != lastMonth)) {
+            keptMonths++;
+            lastMonth = month;
+            keep = true;
+        }
+
+        if (!keep) {
+            filesToDelete.push_back(entry->FileName);
+        }
+    }
+
+    return filesToDelete;
+}
+} // namespace app::svc
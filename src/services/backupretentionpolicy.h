@@ -0,0 +1,58 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "backupcatalog.h"
+
+namespace app::svc
+{
+struct BackupRetentionRules {
+    int KeepDaily = 0;
+    int KeepWeekly = 0;
+    int KeepMonthly = 0;
+};
+
+/*
+ * Grandfather-father-son retention over the backup catalog.
+ * Walking from the newest backup back, the newest backup of each of the last KeepDaily days, KeepWeekly weeks
+ * and KeepMonthly months is kept, and everything no rule claims is selected for deletion.
+ * Backups that failed verification never count towards a rule and are always selected.
+ * Days, weeks (starting on Monday) and months are taken in local time, the same as the dates in backup file names.
+ */
+class BackupRetentionPolicy final
+{
+public:
+    BackupRetentionPolicy() = delete;
+    BackupRetentionPolicy(const BackupRetentionRules& rules);
+    ~BackupRetentionPolicy() = default;
+
+    /* Without any rule there is nothing to decide, so the caller falls back to deleting by age */
+    bool IsEnabled() const;
+
+    /* Expects the entries oldest first, as the catalog returns them. The newest backup is never selected */
+    std::vector<std::string> SelectForDeletion(const std::vector<BackupCatalogEntry>& entries) const;
+
+private:
+    BackupRetentionRules mRules;
+};
+} // namespace app::svc
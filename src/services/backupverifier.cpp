@@ -0,0 +1,60 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupverifier.h"
+
+#include <sqlite_modern_cpp.h>
+
+namespace app::svc
+{
+BackupVerifier::BackupVerifier(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+BackupVerification BackupVerifier::Verify(const std::string& databaseFilePath, bool fullCheck)
+{
+    const char* pragma = fullCheck ? "integrity_check" : "quick_check";
+    bool passed = true;
+
+    try {
+        auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READONLY, nullptr, sqlite::Encoding::UTF8 };
+        sqlite::database backupConnection(databaseFilePath, config);
+
+        backupConnection << "PRAGMA " + std::string(pragma) + "(" + std::to_string(MaxReportedErrors) + ")" >>
+            [&](std::string result) {
+                /* a healthy database yields the single row "ok", anything else describes a problem */
+                if (result != "ok") {
+                    passed = false;
+                    pLogger->error("Backup {0} failed {1}: {2}", databaseFilePath, pragma, result);
+                }
+            };
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on BackupVerifier::Verify() - {0:d} : {1}", e.get_code(), e.what());
+        return BackupVerification::Failed;
+    }
+
+    if (!passed) {
+        return BackupVerification::Failed;
+    }
+
+    pLogger->info("Backup {0} passed {1}", databaseFilePath, pragma);
+    return fullCheck ? BackupVerification::IntegrityCheckPassed : BackupVerification::QuickCheckPassed;
+}
+} // namespace app::svc
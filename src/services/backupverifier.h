@@ -0,0 +1,51 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "backupcatalog.h"
+
+namespace app::svc
+{
+/*
+ * Checks that a backup snapshot is a readable database before it is relied on.
+ * PRAGMA quick_check covers page and record structure in roughly the time of a full read of the file,
+ * while PRAGMA integrity_check also matches every index against its table and is kept for a less frequent schedule.
+ */
+class BackupVerifier final
+{
+public:
+    BackupVerifier() = delete;
+    BackupVerifier(std::shared_ptr<spdlog::logger> logger);
+    ~BackupVerifier() = default;
+
+    BackupVerification Verify(const std::string& databaseFilePath, bool fullCheck);
+
+private:
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    /* each check reports at most this many problems, which is plenty to know a backup is damaged */
+    static constexpr int MaxReportedErrors = 10;
+};
+} // namespace app::svc
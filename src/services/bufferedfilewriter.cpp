@@ -0,0 +1,200 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "bufferedfilewriter.h"
+
+#include <cstring>
+#include <limits>
+
+#include <zlib.h>
+
+namespace app::svc
+{
+namespace
+{
+/* Adding 16 to the window bits makes deflate write a gzip header and trailer instead of a zlib one */
+constexpr int GzipWindowBits = 15 + 16;
+constexpr int DefaultMemoryLevel = 8;
+} // namespace
+
+BufferedFileWriter::BufferedFileWriter(const std::string& filePath)
+    : mFilePath(filePath)
+    , mFile()
+    , pBuffer(std::make_unique<char[]>(BufferSize))
+    , mLength(0)
+    , mBytesWritten(0)
+    , mFileBytesWritten(0)
+    , pStream(nullptr)
+    , pCompressedBuffer(nullptr)
+    , bFailed(false)
+{
+}
+
+BufferedFileWriter::~BufferedFileWriter()
+{
+    Close();
+}
+
+bool BufferedFileWriter::Open()
+{
+    mFile.open(mFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    return mFile.is_open();
+}
+
+bool BufferedFileWriter::OpenCompressed(int compressionLevel)
+{
+    if (compressionLevel < Z_NO_COMPRESSION || compressionLevel > Z_BEST_COMPRESSION) {
+        compressionLevel = Z_DEFAULT_COMPRESSION;
+    }
+
+    pStream = std::make_unique<z_stream_s>();
+    int rc = deflateInit2(
+        pStream.get(), compressionLevel, Z_DEFLATED, GzipWindowBits, DefaultMemoryLevel, Z_DEFAULT_STRATEGY);
+    if (rc != Z_OK) {
+        pStream.reset();
+        return false;
+    }
+
+    pCompressedBuffer = std::make_unique<char[]>(BufferSize);
+
+    if (!Open()) {
+        deflateEnd(pStream.get());
+        pStream.reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool BufferedFileWriter::Close()
+{
+    if (!mFile.is_open()) {
+        return true;
+    }
+
+    Flush();
+
+    if (pStream) {
+        if (!bFailed) {
+            Deflate(nullptr, 0, Z_FINISH);
+        }
+        deflateEnd(pStream.get());
+        pStream.reset();
+    }
+
+    mFile.close();
+
+    return !mFile.fail() && !bFailed;
+}
+
+void BufferedFileWriter::Write(const char* data, std::size_t length)
+{
+    if (length > BufferSize - mLength) {
+        Flush();
+
+        /* Anything at least as large as the buffer goes straight through rather than being copied in pieces */
+        if (length >= BufferSize) {
+            WriteThrough(data, length);
+            mBytesWritten += length;
+            return;
+        }
+    }
+
+    std::memcpy(pBuffer.get() + mLength, data, length);
+    mLength += length;
+    mBytesWritten += length;
+}
+
+void BufferedFileWriter::Write(const std::string& value)
+{
+    Write(value.data(), value.size());
+}
+
+void BufferedFileWriter::Write(char value)
+{
+    if (mLength == BufferSize) {
+        Flush();
+    }
+
+    pBuffer[mLength++] = value;
+    mBytesWritten++;
+}
+
+std::uint64_t BufferedFileWriter::GetBytesWritten() const
+{
+    return mBytesWritten;
+}
+
+std::uint64_t BufferedFileWriter::GetFileBytesWritten() const
+{
+    return mFileBytesWritten;
+}
+
+void BufferedFileWriter::Flush()
+{
+    if (mLength > 0) {
+        WriteThrough(pBuffer.get(), mLength);
+        mLength = 0;
+    }
+}
+
+void BufferedFileWriter::WriteThrough(const char* data, std::size_t length)
+{
+    if (!pStream) {
+        mFile.write(data, static_cast<std::streamsize>(length));
+        mFileBytesWritten += length;
+        return;
+    }
+
+    /* avail_in is only 32 bits wide so very large writes are fed to deflate in slices */
+    constexpr std::size_t MaxSlice = std::numeric_limits<uInt>::max();
+    while (length > 0 && !bFailed) {
+        std::size_t slice = length < MaxSlice ? length : MaxSlice;
+        Deflate(data, slice, Z_NO_FLUSH);
+        data += slice;
+        length -= slice;
+    }
+}
+
+bool BufferedFileWriter::Deflate(const char* data, std::size_t length, int flush)
+{
+    pStream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    pStream->avail_in = static_cast<uInt>(length);
+
+    int rc = Z_OK;
+    do {
+        pStream->next_out = reinterpret_cast<Bytef*>(pCompressedBuffer.get());
+        pStream->avail_out = static_cast<uInt>(BufferSize);
+
+        rc = deflate(pStream.get(), flush);
+        if (rc == Z_STREAM_ERROR) {
+            bFailed = true;
+            return false;
+        }
+
+        std::size_t produced = BufferSize - pStream->avail_out;
+        if (produced > 0) {
+            mFile.write(pCompressedBuffer.get(), static_cast<std::streamsize>(produced));
+            mFileBytesWritten += produced;
+        }
+    } while (pStream->avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+
+    return true;
+}
+} // namespace app::svc
@@ -0,0 +1,78 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+struct z_stream_s;
+
+namespace app::svc
+{
+/*
+ * Collects small writes in a fixed size buffer and hands the file stream one large block at a time.
+ * Memory use stays at BufferSize no matter how much is written.
+ * When opened compressed, each block is run through zlib's deflate and the file is written in gzip format.
+ */
+class BufferedFileWriter final
+{
+public:
+    static constexpr std::size_t BufferSize = 1 << 16;
+
+    BufferedFileWriter() = delete;
+    BufferedFileWriter(const std::string& filePath);
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    ~BufferedFileWriter();
+
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    bool Open();
+    bool OpenCompressed(int compressionLevel);
+    bool Close();
+
+    void Write(const char* data, std::size_t length);
+    void Write(const std::string& value);
+    void Write(char value);
+
+    /* Bytes handed to Write, before any compression */
+    std::uint64_t GetBytesWritten() const;
+    /* Bytes that ended up on disk */
+    std::uint64_t GetFileBytesWritten() const;
+
+private:
+    void Flush();
+    void WriteThrough(const char* data, std::size_t length);
+    bool Deflate(const char* data, std::size_t length, int flush);
+
+    std::string mFilePath;
+    std::ofstream mFile;
+    std::unique_ptr<char[]> pBuffer;
+    std::size_t mLength;
+    std::uint64_t mBytesWritten;
+    std::uint64_t mFileBytesWritten;
+
+    std::unique_ptr<z_stream_s> pStream;
+    std::unique_ptr<char[]> pCompressedBuffer;
+    bool bFailed;
+};
+} // namespace app::svc
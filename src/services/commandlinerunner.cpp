@@ -0,0 +1,208 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "commandlinerunner.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include <sqlite_modern_cpp/errors.h>
+
+#include "../common/civildate.h"
+#include "../common/duration.h"
+#include "../config/configurationprovider.h"
+#include "../data/aggregatedata.h"
+
+#include "backupdirectorylock.h"
+#include "bufferedfilewriter.h"
+#include "csvfieldescaper.h"
+#include "databasebackup.h"
+#include "databasebackupdeleter.h"
+#include "exporter.h"
+
+namespace app::svc
+{
+namespace
+{
+void WriteReportRow(BufferedFileWriter& writer,
+    const CsvFieldEscaper& escaper,
+    char delimiter,
+    const char* type,
+    const std::string& name,
+    int seconds)
+{
+    char duration[common::Duration::MaxFormattedLength];
+    auto durationLength = common::Duration(seconds).Format(duration);
+    auto secondsText = std::to_string(seconds);
+
+    escaper.Write(writer, type, std::char_traits<char>::length(type));
+    writer.Write(delimiter);
+    escaper.Write(writer, name.data(), name.size());
+    writer.Write(delimiter);
+    writer.Write(duration, durationLength);
+    writer.Write(delimiter);
+    writer.Write(secondsText);
+    writer.Write("\r\n", 2);
+}
+} // namespace
+
+CommandLineRunner::CommandLineRunner(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+int CommandLineRunner::Run(const CommandLineOptions& options)
+{
+    switch (options.Command) {
+    case CommandLineCommand::Export:
+        return RunExport(options.Export);
+    case CommandLineCommand::Report:
+        return RunReport(options.Export);
+    case CommandLineCommand::Backup:
+        return RunBackup();
+    case CommandLineCommand::None:
+    default:
+        return ExitUsageError;
+    }
+}
+
+int CommandLineRunner::RunExport(const ExportOptions& options)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    long long rowsWritten = 0;
+    auto exporter = CreateExporter(pLogger, options);
+    auto status = exporter->ExportData([&](long long rows) {
+        rowsWritten = rows;
+        return true;
+    });
+
+    if (status != ExportStatus::Completed) {
+        std::fprintf(stderr, "Export to %s failed, see the log for details\n", options.FilePath.c_str());
+        return ExitFailure;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    std::fprintf(stdout, "Exported %lld rows to %s in %.3fs\n", rowsWritten, options.FilePath.c_str(), elapsed.count());
+    return ExitSuccess;
+}
+
+int CommandLineRunner::RunReport(const ExportOptions& options)
+{
+    common::CivilDate fromDate;
+    common::CivilDate toDate;
+    if (!common::CivilDate::TryParse(options.FromDate.c_str(), options.FromDate.size(), fromDate) ||
+        !common::CivilDate::TryParse(options.ToDate.c_str(), options.ToDate.size(), toDate)) {
+        std::fprintf(stderr, "Report dates must be given as YYYY-MM-DD\n");
+        return ExitUsageError;
+    }
+
+    std::vector<data::DayTotal> dayTotals;
+    std::vector<data::ProjectTotal> projectTotals;
+    std::vector<data::CategoryTotal> categoryTotals;
+    try {
+        data::AggregateData aggregateData;
+        dayTotals = aggregateData.GetDayTotals(fromDate, toDate);
+        projectTotals = aggregateData.GetProjectTotals(fromDate, toDate);
+        categoryTotals = aggregateData.GetCategoryTotals(fromDate, toDate);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on AggregateData - {0:d} : {1}", e.get_code(), e.what());
+        std::fprintf(stderr, "Report failed, see the log for details\n");
+        return ExitFailure;
+    }
+
+    BufferedFileWriter reportFile(options.FilePath);
+    if (!reportFile.Open()) {
+        std::fprintf(stderr, "Unable to create the report file %s\n", options.FilePath.c_str());
+        return ExitFailure;
+    }
+
+    CsvFieldEscaper escaper(options.Delimiter);
+    const char* headers[] = { "Type", "Name", "Duration", "Seconds" };
+    for (int i = 0; i < 4; i++) {
+        if (i > 0) {
+            reportFile.Write(options.Delimiter);
+        }
+        reportFile.Write(headers[i]);
+    }
+    reportFile.Write("\r\n", 2);
+
+    int totalSeconds = 0;
+    for (const auto& dayTotal : dayTotals) {
+        WriteReportRow(reportFile, escaper, options.Delimiter, "Day", dayTotal.Date.ToStdString(), dayTotal.Seconds);
+        totalSeconds += dayTotal.Seconds;
+    }
+    for (const auto& projectTotal : projectTotals) {
+        WriteReportRow(reportFile,
+            escaper,
+            options.Delimiter,
+            "Project",
+            std::string(projectTotal.DisplayName.ToUTF8().data()),
+            projectTotal.Seconds);
+    }
+    for (const auto& categoryTotal : categoryTotals) {
+        WriteReportRow(reportFile,
+            escaper,
+            options.Delimiter,
+            "Category",
+            std::string(categoryTotal.Name.ToUTF8().data()),
+            categoryTotal.Seconds);
+    }
+    WriteReportRow(reportFile, escaper, options.Delimiter, "Total", options.FromDate + " - " + options.ToDate, totalSeconds);
+
+    if (!reportFile.Close()) {
+        std::fprintf(stderr, "Unable to write the report file %s\n", options.FilePath.c_str());
+        return ExitFailure;
+    }
+
+    std::fprintf(stdout, "Wrote report for %s to %s to %s\n", options.FromDate.c_str(), options.ToDate.c_str(), options.FilePath.c_str());
+    return ExitSuccess;
+}
+
+int CommandLineRunner::RunBackup()
+{
+    if (cfg::ConfigurationProvider::Get().Configuration->GetBackupPath().empty()) {
+        std::fprintf(stderr, "No backup path is configured\n");
+        return ExitNotReady;
+    }
+
+    /* the lock the application's backup thread takes, so the two never write snapshots or collect chunks at once */
+    BackupDirectoryLock backupDirectoryLock(pLogger, cfg::ConfigurationProvider::Get().Configuration->GetBackupPath());
+    if (!backupDirectoryLock.Acquire(std::chrono::minutes(1))) {
+        std::fprintf(stderr, "Another backup is using the backup directory, try again later\n");
+        return ExitBusy;
+    }
+
+    DatabaseBackup databaseBackup(pLogger);
+    if (!databaseBackup.Execute()) {
+        std::fprintf(stderr, "Backup failed, see the log for details\n");
+        return ExitFailure;
+    }
+
+    /* keep the same retention the application applies to its own backups */
+    if (cfg::ConfigurationProvider::Get().Configuration->IsBackupEnabled()) {
+        DatabaseBackupDeleter databaseBackupDeleter(pLogger);
+        databaseBackupDeleter.Execute();
+    }
+
+    std::fprintf(stdout, "Backed up the database to %s\n",
+        cfg::ConfigurationProvider::Get().Configuration->GetBackupPath().c_str());
+    return ExitSuccess;
+}
+} // namespace app::svc
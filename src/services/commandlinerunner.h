@@ -0,0 +1,71 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "exportoptions.h"
+
+namespace app::svc
+{
+enum class CommandLineCommand : int { None = 0, Export, Report, Backup };
+
+/* Process exit codes, so scheduled scripts can tell a usage mistake from a failed run */
+enum CommandLineExitCode : int {
+    ExitSuccess = 0,
+    ExitFailure = 1,
+    ExitUsageError = 2,
+    ExitNotReady = 3,
+    /* another backup holds the backup directory, the run can simply be retried later */
+    ExitBusy = 4,
+};
+
+struct CommandLineOptions {
+    CommandLineCommand Command = CommandLineCommand::None;
+    /* Export uses all of these, Report only the date range and the file path */
+    ExportOptions Export;
+    /* as given with --delimiter, empty when the configured delimiter applies */
+    std::string Delimiter;
+};
+
+/*
+ * Runs a single command without any windows: an export, an aggregate report or a database backup.
+ * The application initializes the configuration and the connection pool, nothing else, before calling Run.
+ */
+class CommandLineRunner final
+{
+public:
+    CommandLineRunner() = delete;
+    CommandLineRunner(std::shared_ptr<spdlog::logger> logger);
+    ~CommandLineRunner() = default;
+
+    int Run(const CommandLineOptions& options);
+
+private:
+    int RunExport(const ExportOptions& options);
+    int RunReport(const ExportOptions& options);
+    int RunBackup();
+
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
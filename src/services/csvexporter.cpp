@@ -19,141 +19,99 @@
 
 #include "csvexporter.h"
 
-#include <fstream>
-
-#include <sqlite_modern_cpp/errors.h>
-
-#include "../config/configurationprovider.h"
+#include <cstdio>
 
 namespace app::svc
 {
-std::string CsvExporter::Query = "SELECT "
-                                 "  task_items.start_time "
-                                 ", task_items.end_time "
-                                 ", task_items.duration "
-                                 ", task_items.description "
-                                 ", task_items.calculated_rate "
-                                 ", task_item_types.name "
-                                 ", projects.name "
-                                 ", projects.billable "
-                                 ", projects.rate "
-                                 ", categories.name "
-                                 ", tasks.task_date "
-                                 "FROM task_items "
-                                 "INNER JOIN task_item_types "
-                                 "ON task_items.task_item_type_id = task_item_types.task_item_type_id "
-                                 "INNER JOIN projects "
-                                 "ON task_items.project_id = projects.project_id "
-                                 "INNER JOIN categories "
-                                 "ON task_items.category_id = categories.category_id "
-                                 "INNER JOIN tasks "
-                                 "ON task_items.task_id = tasks.task_id "
-                                 "WHERE tasks.task_date >= ? "
-                                 "AND tasks.task_date <= ? "
-                                 "AND task_items.is_active = 1";
-
-CsvExporter::CsvExporter(std::shared_ptr<spdlog::logger> logger,
-    const std::string& fromDate,
-    const std::string& toDate,
-    const std::string& fileName)
-    : pLogger(logger)
-    , mFromDate(fromDate)
-    , mToDate(mToDate)
-    , mFileName(fileName)
-{
-    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-}
-
-CsvExporter::~CsvExporter()
+CsvExporter::CsvExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options)
+    : QueryExporter(logger,
+          options,
+          CsvExporter::WatermarkName,
+          ExportColumnPlan::Compile(logger, options.Columns),
+          "CSV")
+    , mEscaper(options.Delimiter)
+    , mColumns()
 {
-    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+    CompileColumns();
 }
 
-bool CsvExporter::ExportData()
+void CsvExporter::CompileColumns()
 {
-    /* get raw data from database */
-    std::vector<DataSet*> dataSets;
-    try {
-        dataSets = GetDataSet();
-    } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured in CsvExporter::ExportData - {0:d} : {1}", e.get_code(), e.what());
-        return false;
+    if (mQuery.IsDelta()) {
+        mColumns.push_back(CompiledColumn{
+            &CsvExporter::WriteText, mQuery.GetColumnIndex(ExportQuery::DeltaColumn::TaskItemId), "", "Task Item Id" });
+        mColumns.push_back(CompiledColumn{
+            &CsvExporter::WriteText, mQuery.GetColumnIndex(ExportQuery::DeltaColumn::ChangeType), "", "Change Type" });
     }
 
-    /* get the delimiter */
-    std::string delimiter = cfg::ConfigurationProvider::Get().Configuration->GetDelimiter();
-
-    /* get the export path and combine with filename */
-    std::string exportFilePath = cfg::ConfigurationProvider::Get().Configuration->GetExportPath();
-    std::string fullFilePath = exportFilePath + "\\" + mFileName;
-
-    /* open and create file */
-    std::ofstream csvFile(fullFilePath);
-
-    if (!csvFile) {
-        pLogger->error("Error when trying to create a CSV file at specified location {0}", fullFilePath);
-        return false;
+    for (const auto& column : mQuery.GetColumnPlan().GetColumns()) {
+        const auto& definition = *column.Definition;
+        ColumnWriter write =
+            definition.Type == ExportFieldType::Real ? &CsvExporter::WriteReal : &CsvExporter::WriteText;
+        mColumns.push_back(
+            CompiledColumn{ write, mQuery.GetColumnIndex(definition.Field), definition.NullValue, column.Header });
     }
+}
 
-    /* write the headers */
-    csvFile << "Start Time" << delimiter << "End Time" << delimiter << "Duration" << delimiter << "Description"
-            << delimiter << "Calculated Rate" << delimiter << "Task Item Type" << delimiter << "Project" << delimiter
-            << "Billable" << delimiter << "Project Rate" << delimiter << "Category" << delimiter << "Date"
-            << "\n";
-
-    /* write the data */
-    for (const auto& dataSet : dataSets) {
-        csvFile << (dataSet->StartTime ? *dataSet->StartTime : "N/A") << delimiter
-                << (dataSet->EndTime ? *dataSet->EndTime : "N/A") << delimiter << dataSet->Duration << delimiter
-                << dataSet->Description << delimiter << (dataSet->CalculatedRate ? *dataSet->CalculatedRate : -1)
-                << delimiter << dataSet->TaskItemType << delimiter << dataSet->ProjectName << delimiter
-                << (dataSet->Rate ? *dataSet->Rate : -1) << delimiter << dataSet->CategoryName << delimiter
-                << dataSet->TaskDate << "\n";
+void CsvExporter::WriteHeader(BufferedFileWriter& writer)
+{
+    bool first = true;
+    for (const auto& column : mColumns) {
+        if (!first) {
+            writer.Write(mOptions.Delimiter);
+        }
+        mEscaper.Write(writer, column.Header.data(), column.Header.size());
+        first = false;
     }
+    writer.Write(RecordTerminator, 2);
+}
 
-    /* clean up */
-    csvFile.close();
-
-    while (!dataSets.empty()) {
-        delete dataSets.back();
-        dataSets.pop_back();
+void CsvExporter::WriteRow(BufferedFileWriter& writer, sqlite3_stmt* statement)
+{
+    /* the plan always has at least one column, so the first one is written without a leading delimiter */
+    const CompiledColumn* column = mColumns.data();
+    const CompiledColumn* end = column + mColumns.size();
+
+    column->Write(writer, mEscaper, statement, column->Index, column->NullValue);
+    for (++column; column != end; ++column) {
+        writer.Write(mOptions.Delimiter);
+        column->Write(writer, mEscaper, statement, column->Index, column->NullValue);
     }
-
-    return true;
+    writer.Write(RecordTerminator, 2);
 }
 
-std::vector<CsvExporter::DataSet*> CsvExporter::GetDataSet()
+void CsvExporter::WriteText(BufferedFileWriter& writer,
+    const CsvFieldEscaper& escaper,
+    sqlite3_stmt* statement,
+    int column,
+    const char* nullValue)
 {
-    std::vector<DataSet*> dataSets;
+    /* the text pointer is owned by the statement and stays valid until the next step */
+    auto text = reinterpret_cast<const char*>(sqlite3_column_text(statement, column));
+    if (text == nullptr) {
+        escaper.Write(writer, nullValue, std::char_traits<char>::length(nullValue));
+        return;
+    }
 
-    *pConnection->DatabaseExecutableHandle() << CsvExporter::Query << mFromDate << mToDate >>
-        [&](std::unique_ptr<std::string> taskItemsStartTime,
-            std::unique_ptr<std::string> taskItemsEndTime,
-            std::string taskItemsDuration,
-            std::string taskItemsDescription,
-            std::unique_ptr<double> taskItemsCalculatedRate,
-            std::string taskItemTypesName,
-            std::string projectsName,
-            bool projectsBillable,
-            std::unique_ptr<double> projectsRate,
-            std::string categoriesName,
-            std::string tasksDate) {
-            DataSet* data = new DataSet;
-            data->StartTime = std::move(taskItemsStartTime);
-            data->EndTime = std::move(taskItemsEndTime);
-            data->Duration = taskItemsDuration;
-            data->Description = taskItemsDescription;
-            data->CalculatedRate = std::move(taskItemsCalculatedRate);
-            data->TaskItemType = taskItemTypesName;
-            data->ProjectName = projectsName;
-            data->Billable = projectsBillable;
-            data->Rate = std::move(projectsRate);
-            data->CategoryName = categoriesName;
-            data->TaskDate = tasksDate;
+    escaper.Write(writer, text, static_cast<std::size_t>(sqlite3_column_bytes(statement, column)));
+}
 
-            dataSets.push_back(data);
-        };
+void CsvExporter::WriteReal(BufferedFileWriter& writer,
+    const CsvFieldEscaper& escaper,
+    sqlite3_stmt* statement,
+    int column,
+    const char* nullValue)
+{
+    if (sqlite3_column_type(statement, column) == SQLITE_NULL) {
+        escaper.Write(writer, nullValue, std::char_traits<char>::length(nullValue));
+        return;
+    }
 
-    return dataSets;
+    /* %g matches what the stream based exporter produced for the rate columns */
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%g", sqlite3_column_double(statement, column));
+    if (length > 0) {
+        escaper.Write(writer, buffer, static_cast<std::size_t>(length));
+    }
 }
 } // namespace app::svc
@@ -21,45 +21,65 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
-#include "../database/sqliteconnection.h"
-#include "../database/connectionprovider.h"
+#include "bufferedfilewriter.h"
+#include "csvfieldescaper.h"
+#include "exportoptions.h"
+#include "exportquery.h"
+#include "queryexporter.h"
 
 namespace app::svc
 {
-class CsvExporter
+/*
+ * Formats each stepped row straight into the buffered file.
+ * Column text is read in place from the statement, so no row is ever held in memory after it is written.
+ * The column plan is resolved into a table of column writers once, so each row is a single pass over that table.
+ */
+class CsvExporter final : public QueryExporter
 {
 public:
-    CsvExporter(std::shared_ptr<spdlog::logger> logger, const std::string& fromDate, const std::string& toDate, const std::string& fileName);
-    ~CsvExporter();
+    CsvExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options);
+    virtual ~CsvExporter() = default;
 
-    bool ExportData();
+    /* Key of this exporter's row in export_watermarks */
+    static constexpr const char* WatermarkName = "csv";
 
 private:
-    struct DataSet {
-        std::unique_ptr<std::string> StartTime;
-        std::unique_ptr<std::string> EndTime;
-        std::string Duration;
-        std::string Description;
-        std::unique_ptr<double> CalculatedRate;
-        std::string TaskItemType;
-        std::string ProjectName;
-        bool Billable;
-        std::unique_ptr<double> Rate;
-        std::string CategoryName;
-        std::string TaskDate;
+    using ColumnWriter = void (*)(BufferedFileWriter& writer,
+        const CsvFieldEscaper& escaper,
+        sqlite3_stmt* statement,
+        int column,
+        const char* nullValue);
+
+    struct CompiledColumn {
+        ColumnWriter Write;
+        int Index;
+        const char* NullValue;
+        std::string Header;
     };
 
-    std::vector<CsvExporter::DataSet*> GetDataSet();
+    void CompileColumns();
+    void WriteHeader(BufferedFileWriter& writer) override;
+    void WriteRow(BufferedFileWriter& writer, sqlite3_stmt* statement) override;
+
+    static void WriteText(BufferedFileWriter& writer,
+        const CsvFieldEscaper& escaper,
+        sqlite3_stmt* statement,
+        int column,
+        const char* nullValue);
+    static void WriteReal(BufferedFileWriter& writer,
+        const CsvFieldEscaper& escaper,
+        sqlite3_stmt* statement,
+        int column,
+        const char* nullValue);
 
-    std::shared_ptr<spdlog::logger> pLogger;
-    std::shared_ptr<db::SqliteConnection> pConnection;
-    std::string mFromDate;
-    std::string mToDate;
-    std::string mFileName;
+    /* RFC 4180 ends every record, including the last, with CRLF */
+    static constexpr const char* RecordTerminator = "\r\n";
 
-    static std::string Query;
+    CsvFieldEscaper mEscaper;
+    std::vector<CompiledColumn> mColumns;
 };
 } // namespace app::svc
@@ -0,0 +1,147 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "csvfieldescaper.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSV_FIELD_ESCAPER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace app::svc
+{
+namespace
+{
+#ifdef CSV_FIELD_ESCAPER_SSE2
+/* A byte is 0xFF where the block holds one of the four characters that force quoting */
+inline __m128i SpecialBytes(__m128i block, __m128i delimiter)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i lineFeed = _mm_set1_epi8('\n');
+
+    return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, delimiter), _mm_cmpeq_epi8(block, quote)),
+        _mm_or_si128(_mm_cmpeq_epi8(block, carriageReturn), _mm_cmpeq_epi8(block, lineFeed)));
+}
+#else
+constexpr std::uint64_t LowBits = 0x0101010101010101ULL;
+constexpr std::uint64_t HighBits = 0x8080808080808080ULL;
+
+constexpr std::uint64_t Broadcast(char value)
+{
+    return LowBits * static_cast<unsigned char>(value);
+}
+
+/* Non-zero when any byte of the word is zero */
+constexpr std::uint64_t HasZeroByte(std::uint64_t word)
+{
+    return (word - LowBits) & ~word & HighBits;
+}
+
+constexpr std::uint64_t QuotePattern = Broadcast('"');
+constexpr std::uint64_t CarriageReturnPattern = Broadcast('\r');
+constexpr std::uint64_t LineFeedPattern = Broadcast('\n');
+#endif
+} // namespace
+
+CsvFieldEscaper::CsvFieldEscaper(char delimiter)
+    : mDelimiter(delimiter)
+{
+}
+
+bool CsvFieldEscaper::NeedsQuoting(const char* data, std::size_t length) const
+{
+    std::size_t i = 0;
+#ifdef CSV_FIELD_ESCAPER_SSE2
+    const __m128i delimiter = _mm_set1_epi8(mDelimiter);
+
+    /* two blocks per step, so the single branch is paid once every 32 bytes */
+    for (; i + 2 * sizeof(__m128i) <= length; i += 2 * sizeof(__m128i)) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + sizeof(__m128i)));
+
+        if (_mm_movemask_epi8(_mm_or_si128(SpecialBytes(first, delimiter), SpecialBytes(second, delimiter))) != 0) {
+            return true;
+        }
+    }
+
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(SpecialBytes(block, delimiter)) != 0) {
+            return true;
+        }
+    }
+#else
+    const std::uint64_t delimiterPattern = Broadcast(mDelimiter);
+
+    for (; i + sizeof(std::uint64_t) <= length; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+
+        if (HasZeroByte(word ^ delimiterPattern) | HasZeroByte(word ^ QuotePattern) |
+            HasZeroByte(word ^ CarriageReturnPattern) | HasZeroByte(word ^ LineFeedPattern)) {
+            return true;
+        }
+    }
+#endif
+
+    for (; i < length; i++) {
+        char c = data[i];
+        if (c == mDelimiter || c == '"' || c == '\r' || c == '\n') {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CsvFieldEscaper::Write(BufferedFileWriter& writer, const char* data, std::size_t length) const
+{
+    if (!NeedsQuoting(data, length)) {
+        writer.Write(data, length);
+        return;
+    }
+
+    WriteQuoted(writer, data, length);
+}
+
+void CsvFieldEscaper::WriteQuoted(BufferedFileWriter& writer, const char* data, std::size_t length) const
+{
+    writer.Write('"');
+
+    /* copy the runs between quotes in one go and double each quote */
+    const char* end = data + length;
+    while (data < end) {
+        auto quote = static_cast<const char*>(std::memchr(data, '"', static_cast<std::size_t>(end - data)));
+        if (quote == nullptr) {
+            writer.Write(data, static_cast<std::size_t>(end - data));
+            break;
+        }
+
+        writer.Write(data, static_cast<std::size_t>(quote - data) + 1);
+        writer.Write('"');
+        data = quote + 1;
+    }
+
+    writer.Write('"');
+}
+} // namespace app::svc
@@ -0,0 +1,49 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+
+#include "bufferedfilewriter.h"
+
+namespace app::svc
+{
+/*
+ * Writes CSV fields quoted according to RFC 4180.
+ * A field is quoted only when it contains the delimiter, a double quote, CR or LF, and embedded quotes are doubled.
+ * The scan compares 16 byte blocks with SSE2 (eight byte words elsewhere), so clean fields are found quickly and
+ * written without a copy.
+ */
+class CsvFieldEscaper final
+{
+public:
+    CsvFieldEscaper() = delete;
+    explicit CsvFieldEscaper(char delimiter);
+    ~CsvFieldEscaper() = default;
+
+    bool NeedsQuoting(const char* data, std::size_t length) const;
+    void Write(BufferedFileWriter& writer, const char* data, std::size_t length) const;
+
+private:
+    void WriteQuoted(BufferedFileWriter& writer, const char* data, std::size_t length) const;
+
+    char mDelimiter;
+};
+} // namespace app::svc
@@ -19,19 +19,29 @@
 
 #include "databasebackup.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 
 #include <wx/datetime.h>
 #include <wx/file.h>
+#include <wx/filefn.h>
 #include <wx/stdpaths.h>
 
 #include "../common/common.h"
+#include "../common/version.h"
 #include "../config/configurationprovider.h"
 
+#include "backupcatalog.h"
+#include "backupcompressor.h"
+#include "backupverifier.h"
+#include "incrementalbackupstore.h"
+
 namespace app::svc
 {
 DatabaseBackup::DatabaseBackup(std::shared_ptr<spdlog::logger> logger)
     : pLogger(logger)
+    , pSettings(cfg::ConfigurationProvider::Get().Configuration->GetSnapshot())
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
 }
@@ -41,7 +51,7 @@ DatabaseBackup::~DatabaseBackup()
     db::ConnectionProvider::Get().Handle()->Release(pConnection);
 }
 
-bool DatabaseBackup::Execute()
+bool DatabaseBackup::Execute(BackupProgressCallback progressCallback)
 {
     wxString fileName = CreateBackupFileName();
     wxString filePath = GetBackupFullPath(fileName);
@@ -49,15 +59,105 @@ bool DatabaseBackup::Execute()
         return false;
     }
 
-    if (!CreateBackupFile(filePath)) {
+    wxString temporaryFilePath = filePath + wxT(".tmp");
+    if (!CreateBackupFile(temporaryFilePath)) {
+        return false;
+    }
+    if (!ExecuteBackup(temporaryFilePath, progressCallback)) {
+        wxRemoveFile(temporaryFilePath);
+        return false;
+    }
+
+    /* the plain snapshot is checked, so compressed and incremental backups are verified the same way */
+    BackupVerifier backupVerifier(pLogger);
+    auto verification = backupVerifier.Verify(temporaryFilePath.ToStdString(), IsIntegrityCheckDue());
+
+    /* chunks are always deflated, so an incremental backup makes compressing the whole file redundant */
+    if (pSettings->IncrementalBackups) {
+        filePath += IncrementalBackupStore::ManifestExtension;
+        if (!StoreIncrementalBackup(temporaryFilePath, filePath)) {
+            return false;
+        }
+    } else if (pSettings->CompressBackups) {
+        filePath += BackupCompressor::Extension;
+        if (!CompressBackup(temporaryFilePath, filePath)) {
+            return false;
+        }
+    } else if (!wxRenameFile(temporaryFilePath, filePath, true)) {
+        pLogger->error("Failed to move backup {0} into place", filePath.ToStdString());
+        wxRemoveFile(temporaryFilePath);
         return false;
     }
-    if (!ExecuteBackup(filePath)) {
+
+    RecordBackup(filePath, verification);
+
+    /* a damaged backup stays on disk and in the catalog, marked failed so restore and retention pass it over */
+    return verification != BackupVerification::Failed;
+}
+
+void DatabaseBackup::RecordBackup(const wxString& filePath, BackupVerification verification)
+{
+    /* the backup itself is in place by now, so a catalog failure is logged without failing it */
+    auto backupDirectory = pSettings->BackupPath;
+
+    BackupCatalog backupCatalog(pLogger, backupDirectory);
+    if (!backupCatalog.Record(filePath.ToStdString(), wxDateTime::Now().GetTicks(), FILE_VERSION_STR, verification)) {
+        pLogger->warn("Backup {0} was not recorded in the backup catalog", filePath.ToStdString());
+    }
+}
+
+bool DatabaseBackup::IsIntegrityCheckDue()
+{
+    auto integrityCheckInterval = pSettings->IntegrityCheckInterval;
+    if (integrityCheckInterval <= 0) {
+        return false;
+    }
+
+    auto backupDirectory = pSettings->BackupPath;
+    BackupCatalog backupCatalog(pLogger, backupDirectory);
+
+    std::int64_t lastIntegrityCheck = 0;
+    for (const auto& entry : backupCatalog.GetEntries()) {
+        if (entry.Verification == BackupVerification::IntegrityCheckPassed) {
+            lastIntegrityCheck = std::max(lastIntegrityCheck, entry.Timestamp);
+        }
+    }
+
+    const std::int64_t OneDay = 24 * 60 * 60;
+    return wxDateTime::Now().GetTicks() - lastIntegrityCheck >= OneDay * integrityCheckInterval;
+}
+
+bool DatabaseBackup::CompressBackup(const wxString& snapshotFilePath, const wxString& archiveFilePath)
+{
+    /* the snapshot is a consistent copy, so it is compressed without holding anything open on the live database */
+    wxString temporaryArchiveFilePath = archiveFilePath + wxT(".tmp");
+
+    BackupCompressor backupCompressor(pLogger);
+    bool compressed = backupCompressor.Compress(
+        snapshotFilePath.ToStdString(), temporaryArchiveFilePath.ToStdString(), BackupCompressionLevel);
+    wxRemoveFile(snapshotFilePath);
+    if (!compressed) {
+        return false;
+    }
+
+    if (!wxRenameFile(temporaryArchiveFilePath, archiveFilePath, true)) {
+        pLogger->error("Failed to move backup {0} into place", archiveFilePath.ToStdString());
+        wxRemoveFile(temporaryArchiveFilePath);
         return false;
     }
     return true;
 }
 
+bool DatabaseBackup::StoreIncrementalBackup(const wxString& snapshotFilePath, const wxString& manifestFilePath)
+{
+    auto backupDirectory = pSettings->BackupPath;
+
+    IncrementalBackupStore backupStore(pLogger, backupDirectory);
+    bool stored = backupStore.WriteSnapshot(snapshotFilePath.ToStdString(), manifestFilePath.ToStdString());
+    wxRemoveFile(snapshotFilePath);
+    return stored;
+}
+
 wxString DatabaseBackup::CreateBackupFileName()
 {
     auto dateTime = wxDateTime::Now();
@@ -77,7 +177,7 @@ wxString DatabaseBackup::CreateBackupFileName()
 
 wxString DatabaseBackup::GetBackupFullPath(const wxString& filename)
 {
-    auto backupDirectory = cfg::ConfigurationProvider::Get().Configuration->GetBackupPath();
+    auto backupDirectory = pSettings->BackupPath;
     auto backupFilePath = wxString::Format(wxT("%s\\%s"), backupDirectory, filename);
     return backupFilePath;
 }
@@ -93,27 +193,18 @@ bool DatabaseBackup::CreateBackupFile(const wxString& fileName)
     return success;
 }
 
-bool DatabaseBackup::ExecuteBackup(const wxString& fileName)
+bool DatabaseBackup::ExecuteBackup(const wxString& fileName, BackupProgressCallback progressCallback)
 {
     try {
         auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READWRITE, nullptr, sqlite::Encoding::UTF8 };
         sqlite::database backupConnection(fileName.ToStdString(), config);
         auto existingConnection = pConnection->DatabaseExecutableHandle()->connection();
 
-        auto state = std::unique_ptr<sqlite3_backup, decltype(&sqlite3_backup_finish)>(
-            sqlite3_backup_init(backupConnection.connection().get(), "main", existingConnection.get(), "main"),
-            sqlite3_backup_finish);
-
-        if (state) {
-            int rc = -1;
-            do {
-                rc = sqlite3_backup_step(state.get(), -1);
-            } while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
-        }
+        SqlitePageCopier pageCopier(pLogger);
+        return pageCopier.Copy(existingConnection.get(), backupConnection.connection().get(), progressCallback);
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured when running database backup - {0:d} : {1}", e.get_code(), e.what());
         return false;
     }
-    return true;
 }
 } // namespace app::svc
@@ -25,11 +25,22 @@
 #include <sqlite_modern_cpp.h>
 #include <wx/string.h>
 
+#include "../config/configuration.h"
 #include "../database/connectionprovider.h"
 #include "../database/sqliteconnection.h"
 
+#include "backupcatalog.h"
+#include "sqlitepagecopier.h"
+
 namespace app::svc
 {
+/*
+ * Copies the live database into the backup directory with the online backup API, a few pages at a time.
+ * The copy goes to a temporary file that replaces the backup only once it is complete, so a failed or cancelled
+ * run never loses a backup. With compressed backups enabled that file is then streamed into a .db.gz archive
+ * and removed. Before that the snapshot is verified and the result recorded in the backup catalog, and a damaged
+ * snapshot fails the backup.
+ */
 class DatabaseBackup final
 {
 public:
@@ -37,15 +48,23 @@ class DatabaseBackup final
     DatabaseBackup(std::shared_ptr<spdlog::logger> logger);
     ~DatabaseBackup();
 
-    bool Execute();
+    bool Execute(BackupProgressCallback progressCallback = nullptr);
 
 private:
     wxString CreateBackupFileName();
     wxString GetBackupFullPath(const wxString& fileName);
     bool CreateBackupFile(const wxString& fileName);
-    bool ExecuteBackup(const wxString& fileName);
+    bool ExecuteBackup(const wxString& fileName, BackupProgressCallback progressCallback);
+    bool CompressBackup(const wxString& snapshotFilePath, const wxString& archiveFilePath);
+    bool StoreIncrementalBackup(const wxString& snapshotFilePath, const wxString& manifestFilePath);
+    void RecordBackup(const wxString& filePath, BackupVerification verification);
+    bool IsIntegrityCheckDue();
 
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<db::SqliteConnection> pConnection;
+    /* one run sees one configuration, even if the preferences change while it is on the worker thread */
+    cfg::Configuration::Snapshot pSettings;
+
+    static constexpr int BackupCompressionLevel = 6;
 };
 } // namespace app::svc
@@ -19,68 +19,101 @@
 
 #include "databasebackupdeleter.h"
 
-#include <wx/dir.h>
-#include <wx/filename.h>
-#include <wx/regex.h>
+#include <algorithm>
+
+#include <wx/datetime.h>
+#include <wx/filefn.h>
 
 #include "../common/common.h"
 
+#include "backupcatalog.h"
+#include "backupretentionpolicy.h"
+#include "incrementalbackupstore.h"
+
 namespace app::svc
 {
+DatabaseBackupDeleter::DatabaseBackupDeleter(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+    , pSettings(cfg::ConfigurationProvider::Get().Configuration->GetSnapshot())
+{
+}
+
 bool DatabaseBackupDeleter::Execute()
 {
-    auto filesToDelete = GetFilesForDeletion();
+    auto backupPath = pSettings->BackupPath;
+    BackupCatalog backupCatalog(pLogger, backupPath);
+
+    auto entries = backupCatalog.GetEntries();
+    auto filesToDelete = GetFilesForDeletion(entries);
+
+    /* whatever the rules say, the newest backup known to be good is what a restore would fall back on */
+    auto lastVerifiedEntry = std::find_if(
+        entries.rbegin(), entries.rend(), [](const BackupCatalogEntry& entry) { return entry.IsVerified(); });
+    if (lastVerifiedEntry != entries.rend()) {
+        filesToDelete.erase(
+            std::remove(filesToDelete.begin(), filesToDelete.end(), lastVerifiedEntry->FileName), filesToDelete.end());
+    }
+
     if (filesToDelete.empty()) {
         return true;
     }
 
     auto result = DeleteFilesAfterSpecifiedDate(filesToDelete);
+    result = backupCatalog.Remove(filesToDelete) && result;
+
+    /* chunks are shared between snapshots, so they can only go once no remaining manifest lists them */
+    bool deletedManifest = std::any_of(filesToDelete.begin(), filesToDelete.end(), [](const std::string& fileName) {
+        return IncrementalBackupStore::IsManifest(fileName);
+    });
+    if (deletedManifest) {
+        IncrementalBackupStore backupStore(pLogger, backupPath);
+        result = backupStore.CollectGarbage() && result;
+    }
 
     return result;
 }
 
-wxArrayString DatabaseBackupDeleter::GetFilesForDeletion()
+std::vector<std::string> DatabaseBackupDeleter::GetFilesForDeletion(const std::vector<BackupCatalogEntry>& entries)
 {
-    auto backupPath = cfg::ConfigurationProvider::Get().Configuration->GetBackupPath();
-    auto deleteBackupsAfter = cfg::ConfigurationProvider::Get().Configuration->GetDeleteBackupsAfter();
-
-    wxArrayString backupPathFileNames;
-    wxDir::GetAllFiles(backupPath, &backupPathFileNames, wxEmptyString, wxDIR_FILES);
-
-    wxArrayString filesToDelete;
-
-    for (const auto& file : backupPathFileNames) {
-        wxRegEx dateRegex(wxT("([0-9]{4}-[0-9]{2}-[0-9]{2})"));
-        if (dateRegex.IsValid()) {
-            if (dateRegex.Matches(file)) {
-                wxFileName filename(file);
-                auto dateComponent = dateRegex.GetMatch(file, 0);
-                wxDateTime date;
-                if (!date.ParseDate(dateComponent)) {
-                    return wxArrayString();
-                }
-                const time_t OneDay = 24 * 60 * 60;
-                auto dateOffset = OneDay * deleteBackupsAfter;
-                auto dateNow = wxDateTime::Now().GetTicks();
-                auto olderDate = wxDateTime(dateNow - dateOffset);
-
-                if (date.IsEarlierThan(olderDate)) {
-                    filesToDelete.Add(file);
-                }
-            }
+    BackupRetentionRules rules;
+    rules.KeepDaily = pSettings->KeepDailyBackups;
+    rules.KeepWeekly = pSettings->KeepWeeklyBackups;
+    rules.KeepMonthly = pSettings->KeepMonthlyBackups;
+
+    BackupRetentionPolicy retentionPolicy(rules);
+    if (retentionPolicy.IsEnabled()) {
+        return retentionPolicy.SelectForDeletion(entries);
+    }
+
+    auto deleteBackupsAfter = pSettings->DeleteBackupsAfter;
+
+    const time_t OneDay = 24 * 60 * 60;
+    auto dateOffset = OneDay * deleteBackupsAfter;
+    auto olderThan = wxDateTime::Now().GetTicks() - dateOffset;
+
+    std::vector<std::string> filesToDelete;
+    for (const auto& entry : entries) {
+        if (entry.Timestamp < olderThan) {
+            filesToDelete.push_back(entry.FileName);
         }
     }
 
     return filesToDelete;
 }
 
-bool DatabaseBackupDeleter::DeleteFilesAfterSpecifiedDate(const wxArrayString& filesToDelete)
+bool DatabaseBackupDeleter::DeleteFilesAfterSpecifiedDate(const std::vector<std::string>& filesToDelete)
 {
-    for (const auto& file : filesToDelete) {
-        if (!wxRemoveFile(file)) {
-            return false;
+    auto backupPath = pSettings->BackupPath;
+
+    bool result = true;
+    for (const auto& fileName : filesToDelete) {
+        auto filePath = wxString::Format(wxT("%s\\%s"), backupPath, fileName);
+        /* a backup removed by hand only needs to leave the catalog */
+        if (wxFileExists(filePath) && !wxRemoveFile(filePath)) {
+            pLogger->error("Failed to delete backup {0}", filePath.ToStdString());
+            result = false;
         }
     }
-    return true;
+    return result;
 }
 } // namespace app::svc
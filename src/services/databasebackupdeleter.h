@@ -20,24 +20,31 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
-#include <wx/arrstr.h>
-#include <wx/string.h>
+#include <spdlog/spdlog.h>
 
 #include "../config/configurationprovider.h"
 
+#include "backupcatalog.h"
+
 namespace app::svc
 {
 class DatabaseBackupDeleter final
 {
 public:
-    DatabaseBackupDeleter() = default;
+    DatabaseBackupDeleter() = delete;
+    DatabaseBackupDeleter(std::shared_ptr<spdlog::logger> logger);
     ~DatabaseBackupDeleter() = default;
 
     bool Execute();
 
 private:
-    wxArrayString GetFilesForDeletion();
-    bool DeleteFilesAfterSpecifiedDate(const wxArrayString& filesToDelete);
+    std::vector<std::string> GetFilesForDeletion(const std::vector<BackupCatalogEntry>& entries);
+    bool DeleteFilesAfterSpecifiedDate(const std::vector<std::string>& filesToDelete);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    cfg::Configuration::Snapshot pSettings;
 };
 } // namespace app::svc
@@ -0,0 +1,131 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "databaserestore.h"
+
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+#include <sqlite_modern_cpp.h>
+
+#include "backupcompressor.h"
+#include "backupdirectorylock.h"
+#include "incrementalbackupstore.h"
+
+namespace app::svc
+{
+DatabaseRestore::DatabaseRestore(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+bool DatabaseRestore::Execute(const std::string& backupFilePath,
+    const std::string& databaseFilePath,
+    BackupProgressCallback progressCallback)
+{
+    std::string sourceFilePath = backupFilePath;
+    std::string stagingFilePath = databaseFilePath + ".restore";
+
+    /* a plain backup is read where it is, anything else is unpacked into a database file to copy from first */
+    bool unpacked =
+        IncrementalBackupStore::IsManifest(backupFilePath) || BackupCompressor::IsCompressed(backupFilePath);
+    if (unpacked) {
+        if (!Unpack(backupFilePath, stagingFilePath)) {
+            return false;
+        }
+        sourceFilePath = stagingFilePath;
+    }
+
+    std::error_code error;
+    bool result = false;
+    if (std::filesystem::exists(databaseFilePath, error)) {
+        result = CopyPages(sourceFilePath, databaseFilePath, progressCallback);
+    } else {
+        std::string temporaryFilePath = databaseFilePath + ".tmp";
+        result = CopyPages(sourceFilePath, temporaryFilePath, progressCallback);
+        if (result) {
+            std::filesystem::rename(temporaryFilePath, databaseFilePath, error);
+            if (error) {
+                pLogger->error(
+                    "Failed to move restored database {0} into place - {1}", databaseFilePath, error.message());
+                result = false;
+            }
+        }
+        if (!result) {
+            std::filesystem::remove(temporaryFilePath, error);
+        }
+    }
+
+    if (unpacked) {
+        std::filesystem::remove(stagingFilePath, error);
+    }
+
+    return result;
+}
+
+bool DatabaseRestore::Unpack(const std::string& backupFilePath, const std::string& stagingFilePath)
+{
+    if (IncrementalBackupStore::IsManifest(backupFilePath)) {
+        auto backupPath = std::filesystem::path(backupFilePath).parent_path().string();
+
+        /* keeps a backup's chunk collection from removing chunks while they are read back */
+        BackupDirectoryLock backupDirectoryLock(pLogger, backupPath);
+        if (!backupDirectoryLock.Acquire(std::chrono::minutes(1))) {
+            return false;
+        }
+
+        IncrementalBackupStore backupStore(pLogger, backupPath);
+        if (!backupStore.Restore(backupFilePath, stagingFilePath)) {
+            pLogger->error("Failed to reassemble {0} to {1}", backupFilePath, stagingFilePath);
+            return false;
+        }
+        return true;
+    }
+
+    BackupCompressor backupCompressor(pLogger);
+    if (!backupCompressor.Decompress(backupFilePath, stagingFilePath)) {
+        pLogger->error("Failed to decompress {0} to {1}", backupFilePath, stagingFilePath);
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseRestore::CopyPages(const std::string& sourceFilePath,
+    const std::string& destinationFilePath,
+    BackupProgressCallback progressCallback)
+{
+    try {
+        auto sourceConfig = sqlite::sqlite_config{ sqlite::OpenFlags::READONLY, nullptr, sqlite::Encoding::UTF8 };
+        sqlite::database sourceConnection(sourceFilePath, sourceConfig);
+
+        auto destinationConfig = sqlite::sqlite_config{
+            sqlite::OpenFlags::READWRITE | sqlite::OpenFlags::CREATE, nullptr, sqlite::Encoding::UTF8
+        };
+        sqlite::database destinationConnection(destinationFilePath, destinationConfig);
+
+        SqlitePageCopier pageCopier(pLogger);
+        return pageCopier.Copy(
+            sourceConnection.connection().get(), destinationConnection.connection().get(), progressCallback);
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on DatabaseRestore::CopyPages() - {0:d} : {1}", e.get_code(), e.what());
+        return false;
+    }
+}
+} // namespace app::svc
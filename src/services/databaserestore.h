@@ -0,0 +1,57 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "sqlitepagecopier.h"
+
+namespace app::svc
+{
+/*
+ * Restores a backup into the database with the online backup API, a few pages at a time.
+ * An existing database is overwritten in place inside a single transaction, so an interrupted restore rolls back
+ * and the open connection pool stays valid without being swapped out. A missing database is built in a temporary
+ * file and renamed into place once complete. Compressed and incremental backups are first unpacked next to the
+ * database and copied from there.
+ */
+class DatabaseRestore final
+{
+public:
+    DatabaseRestore() = delete;
+    DatabaseRestore(std::shared_ptr<spdlog::logger> logger);
+    ~DatabaseRestore() = default;
+
+    bool Execute(const std::string& backupFilePath,
+        const std::string& databaseFilePath,
+        BackupProgressCallback progressCallback = nullptr);
+
+private:
+    bool Unpack(const std::string& backupFilePath, const std::string& stagingFilePath);
+    bool CopyPages(const std::string& sourceFilePath,
+        const std::string& destinationFilePath,
+        BackupProgressCallback progressCallback);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
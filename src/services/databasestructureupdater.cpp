@@ -43,9 +43,10 @@ bool DatabaseStructureUpdater::ExecuteScripts()
     bool meetingForeignKeyAdded = AddMeetingForeignKeyToTaskItemsTable();
     bool updateProjects = SoftDropProjectBillableColumns();
     bool updateTaskItems = SoftDropTaskItemBillableColumns();
+    bool exportWatermarksTableCreated = CreateExportWatermarksTableScript();
 
     return projectsHoursColumnDropped && meetingsTableCreated && meetingForeignKeyAdded && updateProjects &&
-           updateTaskItems;
+           updateTaskItems && exportWatermarksTableCreated;
 }
 
 bool DatabaseStructureUpdater::DropProjectsHoursColumn()
@@ -314,4 +315,34 @@ bool DatabaseStructureUpdater::SoftDropTaskItemBillableColumns()
     }
     return true;
 }
+
+bool DatabaseStructureUpdater::CreateExportWatermarksTableScript()
+{
+    const std::string CreateExportWatermarksTableOperationName = "CreateExportWatermarksTableScript";
+
+    const std::string CreateExportWatermarksTable =
+        "CREATE TABLE IF NOT EXISTS export_watermarks "
+        "( "
+        "name TEXT PRIMARY KEY NOT NULL,"
+        "watermark INTEGER NOT NULL,"
+        "date_modified INTEGER NOT NULL DEFAULT(strftime('%s', 'now'))"
+        ");";
+
+    /* delta exports range over date_modified, this must run after task_items is rebuilt above */
+    const std::string CreateTaskItemsDateModifiedIndex =
+        "CREATE INDEX IF NOT EXISTS idx_task_items_date_modified ON task_items(date_modified);";
+
+    try {
+        *pConnection->DatabaseExecutableHandle() << CreateExportWatermarksTable;
+        *pConnection->DatabaseExecutableHandle() << CreateTaskItemsDateModifiedIndex;
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error in database structure update operation {0} | {1:d} : {2}",
+            CreateExportWatermarksTableOperationName,
+            e.get_code(),
+            e.what());
+        return false;
+    }
+
+    return true;
+}
 } // namespace app::svc
@@ -43,6 +43,7 @@ class DatabaseStructureUpdater final
     bool AddMeetingForeignKeyToTaskItemsTable();
     bool SoftDropProjectBillableColumns();
     bool SoftDropTaskItemBillableColumns();
+    bool CreateExportWatermarksTableScript();
 
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<db::SqliteConnection> pConnection;
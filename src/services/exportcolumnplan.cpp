@@ -0,0 +1,131 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "exportcolumnplan.h"
+
+namespace app::svc
+{
+// clang-format off
+static const std::array<ExportFieldDefinition, ExportColumnPlan::FieldCount> FieldDefinitions = { {
+    { ExportField::StartTime, "startTime", "Start Time", "task_items.start_time", ExportFieldType::Text, "N/A" },
+    { ExportField::EndTime, "endTime", "End Time", "task_items.end_time", ExportFieldType::Text, "N/A" },
+    { ExportField::Duration, "duration", "Duration", "task_items.duration", ExportFieldType::Text, "" },
+    { ExportField::Description, "description", "Description", "task_items.description", ExportFieldType::Text, "" },
+    { ExportField::CalculatedRate, "calculatedRate", "Calculated Rate", "task_items.calculated_rate", ExportFieldType::Real, "-1" },
+    { ExportField::TaskItemType, "taskItemType", "Task Item Type", "task_item_types.name", ExportFieldType::Text, "" },
+    { ExportField::Project, "project", "Project", "projects.name", ExportFieldType::Text, "" },
+    { ExportField::Billable, "billable", "Billable", "projects.billable", ExportFieldType::Text, "0" },
+    { ExportField::ProjectRate, "projectRate", "Project Rate", "projects.rate", ExportFieldType::Real, "-1" },
+    { ExportField::Category, "category", "Category", "categories.name", ExportFieldType::Text, "" },
+    { ExportField::Date, "date", "Date", "tasks.task_date", ExportFieldType::Text, "" },
+    { ExportField::Client, "client", "Client", "clients.name", ExportFieldType::Text, "" },
+    { ExportField::Employer, "employer", "Employer", "employers.name", ExportFieldType::Text, "" },
+} };
+// clang-format on
+
+ExportColumnPlan::ExportColumnPlan()
+    : mColumns()
+    , mPositions()
+{
+    mPositions.fill(-1);
+}
+
+ExportColumnPlan ExportColumnPlan::Compile(std::shared_ptr<spdlog::logger> logger,
+    const std::vector<std::string>& columns)
+{
+    ExportColumnPlan plan;
+
+    for (const auto& column : columns) {
+        auto separator = column.find('=');
+        auto key = column.substr(0, separator);
+        auto header = separator == std::string::npos ? std::string() : column.substr(separator + 1);
+
+        const ExportFieldDefinition* definition = nullptr;
+        for (const auto& fieldDefinition : FieldDefinitions) {
+            if (key == fieldDefinition.Key) {
+                definition = &fieldDefinition;
+                break;
+            }
+        }
+
+        if (definition == nullptr) {
+            logger->warn("Ignoring unknown export column \"{0}\"", key);
+            continue;
+        }
+        if (plan.GetColumnPosition(definition->Field) != -1) {
+            logger->warn("Ignoring repeated export column \"{0}\"", key);
+            continue;
+        }
+
+        plan.AddColumn(*definition, header.empty() ? definition->Header : header);
+    }
+
+    if (plan.mColumns.empty()) {
+        for (int i = 0; i < DefaultFieldCount; i++) {
+            plan.AddColumn(FieldDefinitions[i], FieldDefinitions[i].Header);
+        }
+    }
+
+    return plan;
+}
+
+const std::array<ExportFieldDefinition, ExportColumnPlan::FieldCount>& ExportColumnPlan::GetFieldDefinitions()
+{
+    return FieldDefinitions;
+}
+
+const std::vector<ExportColumn>& ExportColumnPlan::GetColumns() const
+{
+    return mColumns;
+}
+
+std::string ExportColumnPlan::GetSelectList() const
+{
+    std::string selectList;
+    for (const auto& column : mColumns) {
+        if (!selectList.empty()) {
+            selectList += ", ";
+        }
+        selectList += column.Definition->Expression;
+    }
+
+    return selectList;
+}
+
+int ExportColumnPlan::GetColumnPosition(ExportField field) const
+{
+    return mPositions[static_cast<int>(field)];
+}
+
+bool ExportColumnPlan::UsesClients() const
+{
+    return GetColumnPosition(ExportField::Client) != -1;
+}
+
+bool ExportColumnPlan::UsesEmployers() const
+{
+    return GetColumnPosition(ExportField::Employer) != -1;
+}
+
+void ExportColumnPlan::AddColumn(const ExportFieldDefinition& definition, const std::string& header)
+{
+    mPositions[static_cast<int>(definition.Field)] = static_cast<int>(mColumns.size());
+    mColumns.push_back(ExportColumn{ &definition, header });
+}
+} // namespace app::svc
@@ -0,0 +1,100 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace app::svc
+{
+/* Every task item value an export can select, in the order of the default column set */
+enum class ExportField : int {
+    StartTime = 0,
+    EndTime,
+    Duration,
+    Description,
+    CalculatedRate,
+    TaskItemType,
+    Project,
+    Billable,
+    ProjectRate,
+    Category,
+    Date,
+    Client,
+    Employer,
+};
+
+enum class ExportFieldType : int { Text = 0, Real };
+
+struct ExportFieldDefinition {
+    ExportField Field;
+    /* name used in the [export] columns setting */
+    const char* Key;
+    const char* Header;
+    const char* Expression;
+    ExportFieldType Type;
+    /* written in place of a NULL value */
+    const char* NullValue;
+};
+
+struct ExportColumn {
+    const ExportFieldDefinition* Definition;
+    std::string Header;
+};
+
+/*
+ * The columns of an export, their order and their headers, resolved from the [export] columns setting.
+ * Each entry is a field key, optionally renamed with key=Header, e.g. columns=["date", "client=Customer", "duration"].
+ * An empty setting selects the original eleven columns. The select list is built from the plan, so the client and
+ * employer tables are only joined when one of their columns is exported.
+ */
+class ExportColumnPlan final
+{
+public:
+    static constexpr int FieldCount = 13;
+    /* the default column set is every field up to and including ExportField::Date */
+    static constexpr int DefaultFieldCount = 11;
+
+    ExportColumnPlan();
+    ~ExportColumnPlan() = default;
+
+    static ExportColumnPlan Compile(std::shared_ptr<spdlog::logger> logger, const std::vector<std::string>& columns);
+    static const std::array<ExportFieldDefinition, FieldCount>& GetFieldDefinitions();
+
+    const std::vector<ExportColumn>& GetColumns() const;
+    /* Select list expressions, comma separated, in column order */
+    std::string GetSelectList() const;
+    /* Position of the field within the select list, or -1 when the plan does not export it */
+    int GetColumnPosition(ExportField field) const;
+
+    bool UsesClients() const;
+    bool UsesEmployers() const;
+
+private:
+    void AddColumn(const ExportFieldDefinition& definition, const std::string& header);
+
+    std::vector<ExportColumn> mColumns;
+    std::array<int, FieldCount> mPositions;
+};
+} // namespace app::svc
@@ -0,0 +1,43 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "exporter.h"
+
+#include "csvexporter.h"
+#include "jsonlinesexporter.h"
+#include "partitionedexporter.h"
+
+namespace app::svc
+{
+std::unique_ptr<IExporter> CreateExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options)
+{
+    /* a delta is selected by modification time, so it has no date range to partition */
+    if (options.Partitioned && !options.Delta) {
+        return std::make_unique<PartitionedExporter>(logger, options);
+    }
+
+    switch (options.Format) {
+    case ExportFormat::JsonLines:
+        return std::make_unique<JsonLinesExporter>(logger, options);
+    case ExportFormat::Csv:
+    default:
+        return std::make_unique<CsvExporter>(logger, options);
+    }
+}
+} // namespace app::svc
@@ -0,0 +1,45 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include "exportoptions.h"
+
+namespace app::svc
+{
+class IExporter
+{
+public:
+    virtual ~IExporter() = default;
+
+    /* May throw a sqlite::sqlite_exception, the estimate is only used for progress reporting */
+    virtual long long EstimateRowCount() = 0;
+    virtual ExportStatus ExportData(ExportProgressCallback progressCallback = nullptr) = 0;
+
+    /* How many rows are written between progress callbacks */
+    static constexpr long long ProgressInterval = 1000;
+};
+
+/* Creates the exporter for options.Format (partitioned when requested), each exporter takes its own pooled connection */
+std::unique_ptr<IExporter> CreateExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options);
+} // namespace app::svc
@@ -0,0 +1,56 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace app::svc
+{
+enum class ExportFormat : int { Csv = 0, JsonLines };
+
+/* Everything an exporter needs, resolved on the UI thread so the export itself never reads the configuration */
+struct ExportOptions {
+    ExportFormat Format = ExportFormat::Csv;
+    std::string FromDate;
+    std::string ToDate;
+    std::string FilePath;
+    char Delimiter = ',';
+    /* the [export] columns setting, see ExportColumnPlan, empty exports the default columns */
+    std::vector<std::string> Columns;
+    /* gzip the output as it is written, CompressionLevel is zlib's 0 (store) to 9 (smallest) */
+    bool Compressed = false;
+    int CompressionLevel = 6;
+    /* export only task items changed since the last delta export, FromDate and ToDate are ignored */
+    bool Delta = false;
+    /* split the date range into months that are exported in parallel, each on its own connection */
+    bool Partitioned = false;
+    /* concatenate the months into FilePath in date order instead of writing a file per month */
+    bool CombinePartitions = false;
+    /* cleared for all but the first month when months are combined, so the header appears once */
+    bool WriteHeader = true;
+};
+
+enum class ExportStatus : int { Completed = 0, Failed, Cancelled };
+
+/* Receives the number of rows written so far, returning false stops the export */
+using ExportProgressCallback = std::function<bool(long long rowsWritten)>;
+} // namespace app::svc
@@ -0,0 +1,244 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "exportquery.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "../data/exportwatermarkdata.h"
+
+namespace app::svc
+{
+std::string ExportQuery::FromClause = "FROM task_items "
+                                      "INNER JOIN task_item_types "
+                                      "ON task_items.task_item_type_id = task_item_types.task_item_type_id "
+                                      "INNER JOIN projects "
+                                      "ON task_items.project_id = projects.project_id "
+                                      "INNER JOIN categories "
+                                      "ON task_items.category_id = categories.category_id "
+                                      "INNER JOIN tasks "
+                                      "ON task_items.task_id = tasks.task_id ";
+
+/* a project does not have to have a client */
+std::string ExportQuery::ClientsJoin = "LEFT JOIN clients "
+                                       "ON projects.client_id = clients.client_id ";
+
+std::string ExportQuery::EmployersJoin = "INNER JOIN employers "
+                                         "ON projects.employer_id = employers.employer_id ";
+
+std::string ExportQuery::WhereClause = "WHERE tasks.task_date >= ? "
+                                       "AND tasks.task_date <= ? "
+                                       "AND task_items.is_active = 1";
+
+std::string ExportQuery::CountQuery = "SELECT COUNT(*) "
+                                      "FROM task_items "
+                                      "INNER JOIN tasks "
+                                      "ON task_items.task_id = tasks.task_id "
+                                      "WHERE tasks.task_date >= ? "
+                                      "AND tasks.task_date <= ? "
+                                      "AND task_items.is_active = 1";
+
+/* ?1 is the previous watermark, ?2 the new one */
+std::string ExportQuery::DeltaColumns = "task_items.task_item_id "
+                                        ", CASE "
+                                        "  WHEN task_items.is_active = 0 THEN 'Deleted' "
+                                        "  WHEN task_items.date_created > ?1 THEN 'Inserted' "
+                                        "  ELSE 'Modified' "
+                                        "  END, ";
+
+std::string ExportQuery::DeltaWhereClause = "WHERE task_items.date_modified > ?1 "
+                                            "AND task_items.date_modified <= ?2 "
+                                            "ORDER BY task_items.date_modified, task_items.task_item_id";
+
+std::string ExportQuery::DeltaCountQuery = "SELECT COUNT(*) "
+                                           "FROM task_items "
+                                           "WHERE task_items.date_modified > ? "
+                                           "AND task_items.date_modified <= ?";
+
+ExportQuery::ExportQuery(std::shared_ptr<spdlog::logger> logger,
+    const ExportOptions& options,
+    const std::string& watermarkName,
+    ExportColumnPlan columnPlan)
+    : pLogger(logger)
+    , pStatement(nullptr, sqlite3_finalize)
+    , mOptions(options)
+    , mWatermarkName(watermarkName)
+    , mColumnPlan(std::move(columnPlan))
+    , mLowWatermark(0)
+    , mHighWatermark(0)
+    , bLowWatermarkRead(false)
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch());
+    mHighWatermark = static_cast<std::int64_t>(now.count()) - WatermarkSettleSeconds;
+}
+
+ExportQuery::~ExportQuery()
+{
+    /* the statement belongs to the connection, so it has to be finalized before the connection goes back */
+    pStatement.reset();
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+}
+
+long long ExportQuery::EstimateRowCount()
+{
+    long long rowCount = 0;
+
+    if (mOptions.Delta) {
+        *pConnection->DatabaseExecutableHandle() << ExportQuery::DeltaCountQuery << GetLowWatermark()
+                                                 << mHighWatermark >>
+            [&](long long count) { rowCount = count; };
+    } else {
+        *pConnection->DatabaseExecutableHandle() << ExportQuery::CountQuery << mOptions.FromDate << mOptions.ToDate >>
+            [&](long long count) { rowCount = count; };
+    }
+
+    return rowCount;
+}
+
+bool ExportQuery::Prepare()
+{
+    if (mOptions.Delta) {
+        try {
+            GetLowWatermark();
+        } catch (const sqlite::sqlite_exception& e) {
+            pLogger->error("Error occured in ExportWatermarkData::Get() - {0:d} : {1}", e.get_code(), e.what());
+            return false;
+        }
+    }
+
+    auto query = BuildQuery();
+    auto connection = pConnection->DatabaseExecutableHandle()->connection();
+    sqlite3_stmt* statementHandle = nullptr;
+    int rc = sqlite3_prepare_v2(connection.get(), query.c_str(), static_cast<int>(query.size()), &statementHandle, nullptr);
+    pStatement.reset(statementHandle);
+
+    if (rc != SQLITE_OK) {
+        pLogger->error("Error occured in ExportQuery::Prepare - {0:d} : {1}", rc, sqlite3_errmsg(connection.get()));
+        return false;
+    }
+
+    if (mOptions.Delta) {
+        sqlite3_bind_int64(pStatement.get(), 1, mLowWatermark);
+        sqlite3_bind_int64(pStatement.get(), 2, mHighWatermark);
+    } else {
+        /* the options outlive the statement, so the text does not need to be copied */
+        sqlite3_bind_text(
+            pStatement.get(), 1, mOptions.FromDate.c_str(), static_cast<int>(mOptions.FromDate.size()), SQLITE_STATIC);
+        sqlite3_bind_text(
+            pStatement.get(), 2, mOptions.ToDate.c_str(), static_cast<int>(mOptions.ToDate.size()), SQLITE_STATIC);
+    }
+
+    return true;
+}
+
+int ExportQuery::Step()
+{
+    return sqlite3_step(pStatement.get());
+}
+
+sqlite3_stmt* ExportQuery::GetStatement() const
+{
+    return pStatement.get();
+}
+
+const char* ExportQuery::GetErrorMessage() const
+{
+    return sqlite3_errmsg(pConnection->DatabaseExecutableHandle()->connection().get());
+}
+
+const ExportColumnPlan& ExportQuery::GetColumnPlan() const
+{
+    return mColumnPlan;
+}
+
+int ExportQuery::GetColumnIndex(Column column) const
+{
+    int position = mColumnPlan.GetColumnPosition(column);
+    if (position == -1) {
+        return -1;
+    }
+
+    return position + (mOptions.Delta ? DeltaColumnCount : 0);
+}
+
+int ExportQuery::GetColumnIndex(DeltaColumn column) const
+{
+    return static_cast<int>(column);
+}
+
+bool ExportQuery::IsDelta() const
+{
+    return mOptions.Delta;
+}
+
+bool ExportQuery::RecordWatermark()
+{
+    if (!mOptions.Delta) {
+        return true;
+    }
+
+    try {
+        data::ExportWatermarkData exportWatermarkData;
+        /* never move backwards, should the clock have been set back since the last delta */
+        exportWatermarkData.Set(mWatermarkName, std::max(mLowWatermark, mHighWatermark));
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured in ExportWatermarkData::Set() - {0:d} : {1}", e.get_code(), e.what());
+        return false;
+    }
+
+    pLogger->info("Delta export {0} covered changes from {1:d} to {2:d}", mWatermarkName, mLowWatermark, mHighWatermark);
+    return true;
+}
+
+std::int64_t ExportQuery::GetLowWatermark()
+{
+    /* read once so the estimate and the export cover exactly the same range */
+    if (!bLowWatermarkRead) {
+        data::ExportWatermarkData exportWatermarkData;
+        mLowWatermark = exportWatermarkData.Get(mWatermarkName);
+        bLowWatermarkRead = true;
+    }
+
+    return mLowWatermark;
+}
+
+std::string ExportQuery::BuildQuery() const
+{
+    std::string query = "SELECT ";
+    if (mOptions.Delta) {
+        query += ExportQuery::DeltaColumns;
+    }
+    query += mColumnPlan.GetSelectList();
+    query += " ";
+    query += ExportQuery::FromClause;
+    if (mColumnPlan.UsesClients()) {
+        query += ExportQuery::ClientsJoin;
+    }
+    if (mColumnPlan.UsesEmployers()) {
+        query += ExportQuery::EmployersJoin;
+    }
+    query += mOptions.Delta ? ExportQuery::DeltaWhereClause : ExportQuery::WhereClause;
+
+    return query;
+}
+} // namespace app::svc
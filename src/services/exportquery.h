@@ -0,0 +1,112 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "../database/sqliteconnection.h"
+#include "../database/connectionprovider.h"
+
+#include "exportcolumnplan.h"
+#include "exportoptions.h"
+
+namespace app::svc
+{
+/*
+ * The task item query every exporter steps through, independent of the output format.
+ * Its select list comes from the column plan, so only the joins the selected columns need are made.
+ * A date range export selects active task items by task date. A delta export selects by task_items.date_modified
+ * between the stored watermark and now, soft deleted rows included, and prefixes each row with the task item id
+ * and its change type. The new watermark is only recorded when the exporter says its output is complete.
+ * The query takes its own pooled connection, so it can run on a worker thread.
+ */
+class ExportQuery final
+{
+public:
+    /* The fields are selected in the order of the column plan, GetColumnIndex maps them to statement columns */
+    using Column = ExportField;
+
+    /* Only present in delta exports, ahead of the columns above */
+    enum class DeltaColumn : int { TaskItemId = 0, ChangeType };
+
+    static constexpr int DeltaColumnCount = 2;
+
+    ExportQuery() = delete;
+    ExportQuery(std::shared_ptr<spdlog::logger> logger,
+        const ExportOptions& options,
+        const std::string& watermarkName,
+        ExportColumnPlan columnPlan);
+    ExportQuery(const ExportQuery&) = delete;
+    ~ExportQuery();
+
+    ExportQuery& operator=(const ExportQuery&) = delete;
+
+    long long EstimateRowCount();
+
+    bool Prepare();
+    /* Returns SQLITE_ROW while there are rows, SQLITE_DONE at the end, or an error code */
+    int Step();
+    sqlite3_stmt* GetStatement() const;
+    const char* GetErrorMessage() const;
+
+    const ExportColumnPlan& GetColumnPlan() const;
+    /* Returns -1 for a column the plan does not select */
+    int GetColumnIndex(Column column) const;
+    int GetColumnIndex(DeltaColumn column) const;
+
+    bool IsDelta() const;
+    bool RecordWatermark();
+
+private:
+    std::int64_t GetLowWatermark();
+    std::string BuildQuery() const;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<db::SqliteConnection> pConnection;
+    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> pStatement;
+    ExportOptions mOptions;
+    std::string mWatermarkName;
+    ExportColumnPlan mColumnPlan;
+
+    std::int64_t mLowWatermark;
+    std::int64_t mHighWatermark;
+    bool bLowWatermarkRead;
+
+    /*
+     * date_modified only has one second resolution, so a delta stops short of the current second
+     * (and allows for a write stamped just before the query started but committed after it).
+     * Those rows are picked up by the next delta instead of being lost.
+     */
+    static constexpr std::int64_t WatermarkSettleSeconds = 2;
+
+    static std::string FromClause;
+    static std::string ClientsJoin;
+    static std::string EmployersJoin;
+    static std::string WhereClause;
+    static std::string DeltaColumns;
+    static std::string DeltaWhereClause;
+    static std::string CountQuery;
+    static std::string DeltaCountQuery;
+};
+} // namespace app::svc
@@ -0,0 +1,325 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "incrementalbackupstore.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <system_error>
+
+#include <zlib.h>
+
+#include "../common/sha256.h"
+
+namespace app::svc
+{
+IncrementalBackupStore::IncrementalBackupStore(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath)
+    : pLogger(logger)
+    , mBackupPath(backupPath)
+    , mChunksPath((std::filesystem::path(backupPath) / "chunks").string())
+{
+}
+
+bool IncrementalBackupStore::WriteSnapshot(const std::string& snapshotFilePath, const std::string& manifestFilePath)
+{
+    std::ifstream snapshotFile(snapshotFilePath, std::ios_base::in | std::ios_base::binary);
+    if (!snapshotFile) {
+        pLogger->error("Failed to open snapshot {0}", snapshotFilePath);
+        return false;
+    }
+
+    Manifest manifest;
+    common::Sha256 fileHash;
+    auto chunk = std::make_unique<char[]>(ChunkSize);
+    std::size_t storedChunks = 0;
+
+    while (snapshotFile) {
+        snapshotFile.read(chunk.get(), ChunkSize);
+        auto bytesRead = static_cast<std::size_t>(snapshotFile.gcount());
+        if (bytesRead == 0) {
+            break;
+        }
+
+        fileHash.Update(chunk.get(), bytesRead);
+        auto chunkHash = common::Sha256::HashHex(chunk.get(), bytesRead);
+
+        bool stored = false;
+        if (!StoreChunk(chunkHash, chunk.get(), bytesRead, stored)) {
+            return false;
+        }
+        if (stored) {
+            storedChunks++;
+        }
+
+        manifest.FileSize += bytesRead;
+        manifest.ChunkHashes.push_back(chunkHash);
+    }
+
+    if (snapshotFile.bad()) {
+        pLogger->error("Failed to read snapshot {0}", snapshotFilePath);
+        return false;
+    }
+
+    manifest.FileHash = common::Sha256::ToHex(fileHash.Finalize());
+    if (!WriteManifest(manifestFilePath, manifest)) {
+        return false;
+    }
+
+    pLogger->info("Incremental backup {0}: {1:d} chunks, {2:d} new",
+        manifestFilePath,
+        manifest.ChunkHashes.size(),
+        storedChunks);
+    return true;
+}
+
+bool IncrementalBackupStore::Restore(const std::string& manifestFilePath, const std::string& destinationFilePath)
+{
+    Manifest manifest;
+    if (!ReadManifest(manifestFilePath, manifest)) {
+        return false;
+    }
+
+    std::ofstream destinationFile(
+        destinationFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!destinationFile) {
+        pLogger->error("Failed to create {0}", destinationFilePath);
+        return false;
+    }
+
+    auto removeDestination = [&]() {
+        destinationFile.close();
+        std::error_code error;
+        std::filesystem::remove(destinationFilePath, error);
+        return false;
+    };
+
+    common::Sha256 fileHash;
+    std::uint64_t fileSize = 0;
+    auto chunk = std::make_unique<char[]>(ChunkSize);
+    std::vector<char> compressedChunk;
+
+    for (const auto& chunkHash : manifest.ChunkHashes) {
+        std::ifstream chunkFile(GetChunkFilePath(chunkHash), std::ios_base::in | std::ios_base::binary);
+        if (!chunkFile) {
+            pLogger->error("Backup chunk {0} of {1} is missing", chunkHash, manifestFilePath);
+            return removeDestination();
+        }
+        compressedChunk.assign(std::istreambuf_iterator<char>(chunkFile), std::istreambuf_iterator<char>());
+
+        uLongf chunkLength = static_cast<uLongf>(ChunkSize);
+        int rc = uncompress(reinterpret_cast<Bytef*>(chunk.get()),
+            &chunkLength,
+            reinterpret_cast<const Bytef*>(compressedChunk.data()),
+            static_cast<uLong>(compressedChunk.size()));
+        if (rc != Z_OK || common::Sha256::HashHex(chunk.get(), chunkLength) != chunkHash) {
+            pLogger->error("Backup chunk {0} of {1} is damaged", chunkHash, manifestFilePath);
+            return removeDestination();
+        }
+
+        fileHash.Update(chunk.get(), chunkLength);
+        fileSize += chunkLength;
+        destinationFile.write(chunk.get(), static_cast<std::streamsize>(chunkLength));
+    }
+
+    if (fileSize != manifest.FileSize || common::Sha256::ToHex(fileHash.Finalize()) != manifest.FileHash) {
+        pLogger->error("Snapshot reassembled from {0} does not match its manifest", manifestFilePath);
+        return removeDestination();
+    }
+
+    destinationFile.close();
+    if (!destinationFile) {
+        pLogger->error("Failed to write {0}", destinationFilePath);
+        return removeDestination();
+    }
+
+    return true;
+}
+
+bool IncrementalBackupStore::CollectGarbage()
+{
+    auto runStartTime = std::filesystem::file_time_type::clock::now();
+
+    std::error_code error;
+    if (!std::filesystem::exists(mChunksPath, error)) {
+        return true;
+    }
+
+    /* a manifest that cannot be read keeps every chunk, rather than risk deleting chunks it needs */
+    std::set<std::string> referencedChunks;
+    for (const auto& entry : std::filesystem::directory_iterator(mBackupPath, error)) {
+        if (!entry.is_regular_file() || !IsManifest(entry.path().string())) {
+            continue;
+        }
+
+        Manifest manifest;
+        if (!ReadManifest(entry.path().string(), manifest)) {
+            return false;
+        }
+        referencedChunks.insert(manifest.ChunkHashes.begin(), manifest.ChunkHashes.end());
+    }
+    if (error) {
+        pLogger->error("Failed to list backups in {0} - {1}", mBackupPath, error.message());
+        return false;
+    }
+
+    std::size_t removedChunks = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(mChunksPath, error)) {
+        if (entry.is_regular_file() && referencedChunks.count(entry.path().filename().string()) == 0) {
+            /* a chunk still being written is never touched, only the leftovers of an earlier, interrupted run */
+            if (entry.path().extension() == ".tmp") {
+                std::error_code timeError;
+                auto lastWriteTime = entry.last_write_time(timeError);
+                if (timeError || lastWriteTime >= runStartTime) {
+                    continue;
+                }
+            }
+
+            std::error_code removeError;
+            if (std::filesystem::remove(entry.path(), removeError)) {
+                removedChunks++;
+            }
+        }
+    }
+
+    pLogger->info("Removed {0:d} unreferenced backup chunks", removedChunks);
+    return true;
+}
+
+bool IncrementalBackupStore::IsManifest(const std::string& filePath)
+{
+    return std::filesystem::path(filePath).extension() == ManifestExtension;
+}
+
+bool IncrementalBackupStore::ReadManifest(const std::string& manifestFilePath, Manifest& manifest)
+{
+    std::ifstream manifestFile(manifestFilePath);
+    std::string header;
+    std::string chunkSizeKey;
+    std::size_t chunkSize = 0;
+    std::string fileSizeKey;
+    std::string fileHashKey;
+
+    if (!std::getline(manifestFile, header) || header != ManifestHeader ||
+        !(manifestFile >> chunkSizeKey >> chunkSize >> fileSizeKey >> manifest.FileSize >> fileHashKey >>
+            manifest.FileHash) ||
+        chunkSizeKey != "chunk-size" || chunkSize != ChunkSize || fileSizeKey != "file-size" ||
+        fileHashKey != "sha256") {
+        pLogger->error("Backup manifest {0} is not readable", manifestFilePath);
+        return false;
+    }
+
+    std::string chunkHash;
+    while (manifestFile >> chunkHash) {
+        manifest.ChunkHashes.push_back(chunkHash);
+    }
+
+    return true;
+}
+
+bool IncrementalBackupStore::WriteManifest(const std::string& manifestFilePath, const Manifest& manifest)
+{
+    /* the manifest is what makes a snapshot visible, so it only appears once it is complete */
+    std::string temporaryFilePath = manifestFilePath + ".tmp";
+    {
+        std::ofstream manifestFile(temporaryFilePath, std::ios_base::out | std::ios_base::trunc);
+        manifestFile << ManifestHeader << '\n'
+                     << "chunk-size " << ChunkSize << '\n'
+                     << "file-size " << manifest.FileSize << '\n'
+                     << "sha256 " << manifest.FileHash << '\n';
+        for (const auto& chunkHash : manifest.ChunkHashes) {
+            manifestFile << chunkHash << '\n';
+        }
+
+        manifestFile.close();
+        if (!manifestFile) {
+            pLogger->error("Failed to write backup manifest {0}", temporaryFilePath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryFilePath, manifestFilePath, error);
+    if (error) {
+        pLogger->error("Failed to move backup manifest {0} into place - {1}", manifestFilePath, error.message());
+        std::filesystem::remove(temporaryFilePath, error);
+        return false;
+    }
+
+    return true;
+}
+
+bool IncrementalBackupStore::StoreChunk(const std::string& hash, const char* data, std::size_t length, bool& stored)
+{
+    auto chunkFilePath = GetChunkFilePath(hash);
+
+    std::error_code error;
+    if (std::filesystem::exists(chunkFilePath, error)) {
+        stored = false;
+        return true;
+    }
+
+    std::filesystem::create_directories(std::filesystem::path(chunkFilePath).parent_path(), error);
+    if (error) {
+        pLogger->error("Failed to create backup chunk directory for {0} - {1}", chunkFilePath, error.message());
+        return false;
+    }
+
+    uLongf compressedLength = compressBound(static_cast<uLong>(length));
+    auto compressedChunk = std::make_unique<char[]>(compressedLength);
+    int rc = compress2(reinterpret_cast<Bytef*>(compressedChunk.get()),
+        &compressedLength,
+        reinterpret_cast<const Bytef*>(data),
+        static_cast<uLong>(length),
+        ChunkCompressionLevel);
+    if (rc != Z_OK) {
+        pLogger->error("Failed to compress backup chunk {0} - {1:d}", hash, rc);
+        return false;
+    }
+
+    /* written aside and renamed, so an interrupted backup never leaves a truncated chunk under its hash */
+    std::string temporaryFilePath = chunkFilePath + ".tmp";
+    {
+        std::ofstream chunkFile(temporaryFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        chunkFile.write(compressedChunk.get(), static_cast<std::streamsize>(compressedLength));
+        chunkFile.close();
+        if (!chunkFile) {
+            pLogger->error("Failed to write backup chunk {0}", temporaryFilePath);
+            std::filesystem::remove(temporaryFilePath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryFilePath, chunkFilePath, error);
+    if (error) {
+        pLogger->error("Failed to move backup chunk {0} into place - {1}", chunkFilePath, error.message());
+        std::filesystem::remove(temporaryFilePath, error);
+        return false;
+    }
+
+    stored = true;
+    return true;
+}
+
+std::string IncrementalBackupStore::GetChunkFilePath(const std::string& hash) const
+{
+    /* fanned out by the first two hex digits so no directory grows too large */
+    return (std::filesystem::path(mChunksPath) / hash.substr(0, 2) / hash).string();
+}
+} // namespace app::svc
@@ -0,0 +1,79 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace app::svc
+{
+/*
+ * A content addressed store of database snapshots in the backup directory.
+ * A snapshot is split into fixed size chunks that are named by their SHA-256 and kept deflated under chunks/,
+ * so a chunk that is already stored is never written again. Each snapshot is described by a small text manifest
+ * listing its chunk hashes in order, which is all a restore needs to reassemble the file and verify it.
+ */
+class IncrementalBackupStore final
+{
+public:
+    /* 16 pages of the default 4 KB page size, so a changed page dirties a single chunk */
+    static constexpr std::size_t ChunkSize = 1 << 16;
+    static constexpr const char* ManifestExtension = ".manifest";
+
+    IncrementalBackupStore() = delete;
+    IncrementalBackupStore(std::shared_ptr<spdlog::logger> logger, const std::string& backupPath);
+    ~IncrementalBackupStore() = default;
+
+    bool WriteSnapshot(const std::string& snapshotFilePath, const std::string& manifestFilePath);
+    /* The destination is removed again if a chunk is missing or any hash does not match */
+    bool Restore(const std::string& manifestFilePath, const std::string& destinationFilePath);
+    /*
+     * Removes the chunks no manifest in the backup directory refers to any more, and the temporary chunk files left
+     * behind by earlier runs. Callers hold the BackupDirectoryLock, so no snapshot is written at the same time.
+     */
+    bool CollectGarbage();
+
+    static bool IsManifest(const std::string& filePath);
+
+private:
+    struct Manifest {
+        std::uint64_t FileSize = 0;
+        std::string FileHash;
+        std::vector<std::string> ChunkHashes;
+    };
+
+    bool ReadManifest(const std::string& manifestFilePath, Manifest& manifest);
+    bool WriteManifest(const std::string& manifestFilePath, const Manifest& manifest);
+    bool StoreChunk(const std::string& hash, const char* data, std::size_t length, bool& stored);
+    std::string GetChunkFilePath(const std::string& hash) const;
+
+    static constexpr const char* ManifestHeader = "taskable-incremental-backup 1";
+    static constexpr int ChunkCompressionLevel = 6;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::string mBackupPath;
+    std::string mChunksPath;
+};
+} // namespace app::svc
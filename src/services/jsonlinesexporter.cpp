@@ -0,0 +1,113 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "jsonlinesexporter.h"
+
+#include <nlohmann/json.hpp>
+
+#include "../common/duration.h"
+
+using json = nlohmann::ordered_json;
+
+namespace app::svc
+{
+namespace
+{
+const char* ColumnText(sqlite3_stmt* statement, int column)
+{
+    return reinterpret_cast<const char*>(sqlite3_column_text(statement, column));
+}
+
+json TextOrNull(sqlite3_stmt* statement, int column)
+{
+    auto text = ColumnText(statement, column);
+    if (text == nullptr) {
+        return nullptr;
+    }
+    return std::string(text, static_cast<std::size_t>(sqlite3_column_bytes(statement, column)));
+}
+
+json RealOrNull(sqlite3_stmt* statement, int column)
+{
+    if (sqlite3_column_type(statement, column) == SQLITE_NULL) {
+        return nullptr;
+    }
+    return sqlite3_column_double(statement, column);
+}
+
+/* Times are stored as HH:MM:SS on their own, the task date makes them a full ISO date time */
+json DateTimeOrNull(sqlite3_stmt* statement, int column, const char* date)
+{
+    auto time = ColumnText(statement, column);
+    if (time == nullptr || date == nullptr) {
+        return nullptr;
+    }
+    return std::string(date) + "T" + time;
+}
+
+json SecondsOrNull(sqlite3_stmt* statement, int column)
+{
+    auto text = ColumnText(statement, column);
+    common::Duration duration;
+    if (text == nullptr ||
+        !common::Duration::TryParse(text, static_cast<std::size_t>(sqlite3_column_bytes(statement, column)), duration)) {
+        return nullptr;
+    }
+    return duration.GetTotalSeconds();
+}
+} // namespace
+
+JsonLinesExporter::JsonLinesExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options)
+    : QueryExporter(logger,
+          options,
+          JsonLinesExporter::WatermarkName,
+          ExportColumnPlan::Compile(logger, std::vector<std::string>()),
+          "JSON Lines")
+{
+}
+
+void JsonLinesExporter::WriteRow(BufferedFileWriter& writer, sqlite3_stmt* statement)
+{
+    using Column = ExportQuery::Column;
+
+    auto date = ColumnText(statement, mQuery.GetColumnIndex(Column::Date));
+
+    json row;
+    if (mQuery.IsDelta()) {
+        row["taskItemId"] = sqlite3_column_int64(statement, mQuery.GetColumnIndex(ExportQuery::DeltaColumn::TaskItemId));
+        row["changeType"] = TextOrNull(statement, mQuery.GetColumnIndex(ExportQuery::DeltaColumn::ChangeType));
+    }
+
+    row["date"] = TextOrNull(statement, mQuery.GetColumnIndex(Column::Date));
+    row["startTime"] = DateTimeOrNull(statement, mQuery.GetColumnIndex(Column::StartTime), date);
+    row["endTime"] = DateTimeOrNull(statement, mQuery.GetColumnIndex(Column::EndTime), date);
+    row["durationSeconds"] = SecondsOrNull(statement, mQuery.GetColumnIndex(Column::Duration));
+    row["description"] = TextOrNull(statement, mQuery.GetColumnIndex(Column::Description));
+    row["calculatedRate"] = RealOrNull(statement, mQuery.GetColumnIndex(Column::CalculatedRate));
+    row["taskItemType"] = TextOrNull(statement, mQuery.GetColumnIndex(Column::TaskItemType));
+    row["project"] = TextOrNull(statement, mQuery.GetColumnIndex(Column::Project));
+    row["billable"] = sqlite3_column_int(statement, mQuery.GetColumnIndex(Column::Billable)) != 0;
+    row["projectRate"] = RealOrNull(statement, mQuery.GetColumnIndex(Column::ProjectRate));
+    row["category"] = TextOrNull(statement, mQuery.GetColumnIndex(Column::Category));
+
+    /* descriptions are free text, invalid UTF-8 is replaced rather than failing the whole export */
+    writer.Write(row.dump(-1, ' ', false, json::error_handler_t::replace));
+    writer.Write('\n');
+}
+} // namespace app::svc
@@ -0,0 +1,51 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "bufferedfilewriter.h"
+#include "exportoptions.h"
+#include "queryexporter.h"
+
+namespace app::svc
+{
+/*
+ * Writes one JSON object per task item and line (NDJSON), with typed values instead of CSV text:
+ * the duration in whole seconds, start and end as ISO date times, billable as a boolean and null for missing values.
+ * Each object is built and serialized as its row is stepped, so memory use does not grow with the export.
+ * The fields are fixed, the [export] columns setting only shapes CSV exports.
+ */
+class JsonLinesExporter final : public QueryExporter
+{
+public:
+    JsonLinesExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options);
+    virtual ~JsonLinesExporter() = default;
+
+    /* Key of this exporter's row in export_watermarks */
+    static constexpr const char* WatermarkName = "jsonlines";
+
+private:
+    void WriteRow(BufferedFileWriter& writer, sqlite3_stmt* statement) override;
+};
+} // namespace app::svc
@@ -0,0 +1,235 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "partitionedexporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "../common/civildate.h"
+
+#include "bufferedfilewriter.h"
+
+namespace app::svc
+{
+PartitionedExporter::PartitionedExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options)
+    : pLogger(logger)
+    , mOptions(options)
+{
+}
+
+long long PartitionedExporter::EstimateRowCount()
+{
+    ExportOptions wholeRange = mOptions;
+    wholeRange.Partitioned = false;
+
+    return CreateExporter(pLogger, wholeRange)->EstimateRowCount();
+}
+
+ExportStatus PartitionedExporter::ExportData(ExportProgressCallback progressCallback)
+{
+    auto partitions = CreatePartitions();
+    if (partitions.empty()) {
+        pLogger->error("Cannot partition the export range {0} to {1}", mOptions.FromDate, mOptions.ToDate);
+        return ExportStatus::Failed;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+    std::size_t workerCount = std::min({ MaxWorkers, static_cast<std::size_t>(cores), partitions.size() });
+
+    std::atomic<std::size_t> nextPartition(0);
+    std::atomic<std::size_t> finishedWorkers(0);
+    std::atomic<long long> rowsWritten(0);
+    std::atomic<bool> cancelled(false);
+    std::atomic<bool> failed(false);
+
+    /* workers only touch their own partition and the atomics above, progress is reported from this thread */
+    auto worker = [&]() {
+        std::size_t index = 0;
+        while (!cancelled && !failed && (index = nextPartition++) < partitions.size()) {
+            long long partitionRows = 0;
+            auto exporter = CreateExporter(pLogger, partitions[index]);
+            auto status = exporter->ExportData([&](long long rows) {
+                rowsWritten += rows - partitionRows;
+                partitionRows = rows;
+                return !cancelled.load();
+            });
+
+            if (status == ExportStatus::Failed) {
+                failed = true;
+            }
+        }
+        finishedWorkers++;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(worker);
+    }
+
+    constexpr auto ProgressPollInterval = std::chrono::milliseconds(100);
+    while (finishedWorkers < workerCount) {
+        std::this_thread::sleep_for(ProgressPollInterval);
+        if (progressCallback && !cancelled && !progressCallback(rowsWritten)) {
+            cancelled = true;
+        }
+    }
+
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (failed || cancelled) {
+        RemovePartitionFiles(partitions);
+        if (failed) {
+            pLogger->error("Partitioned export to {0} failed, no partition files were kept", mOptions.FilePath);
+            return ExportStatus::Failed;
+        }
+        pLogger->info("Partitioned export to {0} cancelled after {1:d} rows", mOptions.FilePath, rowsWritten.load());
+        return ExportStatus::Cancelled;
+    }
+
+    if (mOptions.CombinePartitions && !CombinePartitions(partitions)) {
+        RemovePartitionFiles(partitions);
+        return ExportStatus::Failed;
+    }
+
+    if (progressCallback) {
+        progressCallback(rowsWritten);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    pLogger->info("Exported {0:d} rows in {1:d} monthly partitions on {2:d} workers in {3:.3f}s",
+        rowsWritten.load(),
+        partitions.size(),
+        workerCount,
+        elapsed.count());
+
+    return ExportStatus::Completed;
+}
+
+std::vector<ExportOptions> PartitionedExporter::CreatePartitions() const
+{
+    std::vector<ExportOptions> partitions;
+
+    common::CivilDate from;
+    common::CivilDate to;
+    if (!common::CivilDate::TryParse(mOptions.FromDate.c_str(), mOptions.FromDate.size(), from) ||
+        !common::CivilDate::TryParse(mOptions.ToDate.c_str(), mOptions.ToDate.size(), to) || to < from) {
+        return partitions;
+    }
+
+    common::CivilDate monthStart = from;
+    while (monthStart <= to) {
+        int year = monthStart.GetYear();
+        int month = monthStart.GetMonth();
+        auto nextMonth = month == 12 ? common::CivilDate::FromYearMonthDay(year + 1, 1, 1)
+                                     : common::CivilDate::FromYearMonthDay(year, month + 1, 1);
+        auto monthEnd = std::min(nextMonth.AddDays(-1), to);
+
+        char fromBuffer[common::CivilDate::ISODateLength];
+        char toBuffer[common::CivilDate::ISODateLength];
+        monthStart.FormatISODate(fromBuffer);
+        monthEnd.FormatISODate(toBuffer);
+
+        ExportOptions partition = mOptions;
+        partition.Partitioned = false;
+        partition.FromDate = fromBuffer;
+        partition.ToDate = toBuffer;
+        /* YYYY-MM */
+        partition.FilePath = GetPartitionFilePath(std::string(fromBuffer, 7));
+        partition.WriteHeader = !mOptions.CombinePartitions || partitions.empty();
+
+        partitions.push_back(std::move(partition));
+        monthStart = nextMonth;
+    }
+
+    return partitions;
+}
+
+std::string PartitionedExporter::GetPartitionFilePath(const std::string& month) const
+{
+    /* combined months are only staged next to the final file */
+    if (mOptions.CombinePartitions) {
+        return mOptions.FilePath + ".part-" + month;
+    }
+
+    /* Export.csv.gz becomes Export_2020-01.csv.gz */
+    auto nameStart = mOptions.FilePath.find_last_of("\\/");
+    nameStart = nameStart == std::string::npos ? 0 : nameStart + 1;
+    auto extensionStart = mOptions.FilePath.find('.', nameStart);
+    if (extensionStart == std::string::npos) {
+        return mOptions.FilePath + "_" + month;
+    }
+
+    std::string filePath = mOptions.FilePath;
+    filePath.insert(extensionStart, "_" + month);
+    return filePath;
+}
+
+bool PartitionedExporter::CombinePartitions(const std::vector<ExportOptions>& partitions)
+{
+    /* the partitions are already formatted (and compressed), so combining them is a plain byte copy */
+    BufferedFileWriter combinedFile(mOptions.FilePath);
+    if (!combinedFile.Open()) {
+        pLogger->error("Error when trying to create the combined export file at {0}", mOptions.FilePath);
+        return false;
+    }
+
+    auto buffer = std::make_unique<char[]>(BufferedFileWriter::BufferSize);
+    for (const auto& partition : partitions) {
+        std::ifstream partitionFile(partition.FilePath, std::ios::in | std::ios::binary);
+        if (!partitionFile.is_open()) {
+            pLogger->error("Error when trying to read the export partition at {0}", partition.FilePath);
+            combinedFile.Close();
+            std::remove(mOptions.FilePath.c_str());
+            return false;
+        }
+
+        while (partitionFile) {
+            partitionFile.read(buffer.get(), BufferedFileWriter::BufferSize);
+            combinedFile.Write(buffer.get(), static_cast<std::size_t>(partitionFile.gcount()));
+        }
+    }
+
+    if (!combinedFile.Close()) {
+        pLogger->error("Error when writing the combined export file at {0}", mOptions.FilePath);
+        std::remove(mOptions.FilePath.c_str());
+        return false;
+    }
+
+    RemovePartitionFiles(partitions);
+    return true;
+}
+
+void PartitionedExporter::RemovePartitionFiles(const std::vector<ExportOptions>& partitions)
+{
+    /* cancelled or failed partitions have already removed their own file */
+    for (const auto& partition : partitions) {
+        std::remove(partition.FilePath.c_str());
+    }
+}
+} // namespace app::svc
@@ -0,0 +1,61 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "exporter.h"
+#include "exportoptions.h"
+
+namespace app::svc
+{
+/*
+ * Splits a date range export into calendar months and exports them on a small pool of worker threads.
+ * Every month is a complete export of its own, with its own exporter and pooled read connection.
+ * The months are either left as one file each, named after the month, or concatenated in date order into the
+ * requested file. Compressed months are independent gzip members, which gzip readers take as one stream.
+ */
+class PartitionedExporter final : public IExporter
+{
+public:
+    PartitionedExporter(std::shared_ptr<spdlog::logger> logger, const ExportOptions& options);
+    virtual ~PartitionedExporter() = default;
+
+    long long EstimateRowCount() override;
+    ExportStatus ExportData(ExportProgressCallback progressCallback = nullptr) override;
+
+    /* Exports are I/O and formatting bound, more workers than this only contend for the database file */
+    static constexpr std::size_t MaxWorkers = 4;
+
+private:
+    std::vector<ExportOptions> CreatePartitions() const;
+    std::string GetPartitionFilePath(const std::string& month) const;
+    bool CombinePartitions(const std::vector<ExportOptions>& partitions);
+    void RemovePartitionFiles(const std::vector<ExportOptions>& partitions);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    ExportOptions mOptions;
+};
+} // namespace app::svc
@@ -0,0 +1,122 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "queryexporter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+namespace app::svc
+{
+QueryExporter::QueryExporter(std::shared_ptr<spdlog::logger> logger,
+    const ExportOptions& options,
+    const std::string& watermarkName,
+    ExportColumnPlan columnPlan,
+    const char* formatName)
+    : pLogger(logger)
+    , mOptions(options)
+    , mQuery(logger, options, watermarkName, std::move(columnPlan))
+    , pFormatName(formatName)
+{
+}
+
+long long QueryExporter::EstimateRowCount()
+{
+    return mQuery.EstimateRowCount();
+}
+
+ExportStatus QueryExporter::ExportData(ExportProgressCallback progressCallback)
+{
+    /* open and create file */
+    BufferedFileWriter file(mOptions.FilePath);
+    bool opened = mOptions.Compressed ? file.OpenCompressed(mOptions.CompressionLevel) : file.Open();
+    if (!opened) {
+        pLogger->error(
+            "Error when trying to create a {0} file at specified location {1}", pFormatName, mOptions.FilePath);
+        return ExportStatus::Failed;
+    }
+
+    /* a partial file is never left behind, whether the export failed or was cancelled */
+    auto removePartialFile = [&](ExportStatus status) {
+        file.Close();
+        std::remove(mOptions.FilePath.c_str());
+        return status;
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!mQuery.Prepare()) {
+        return removePartialFile(ExportStatus::Failed);
+    }
+
+    if (mOptions.WriteHeader) {
+        WriteHeader(file);
+    }
+
+    /* write each row as it is stepped */
+    int rc = SQLITE_OK;
+    long long rowCount = 0;
+    while ((rc = mQuery.Step()) == SQLITE_ROW) {
+        WriteRow(file, mQuery.GetStatement());
+        rowCount++;
+
+        if (progressCallback && rowCount % ProgressInterval == 0 && !progressCallback(rowCount)) {
+            pLogger->info("{0} export to {1} cancelled after {2:d} rows", pFormatName, mOptions.FilePath, rowCount);
+            return removePartialFile(ExportStatus::Cancelled);
+        }
+    }
+
+    if (rc != SQLITE_DONE) {
+        pLogger->error("Error occured in the {0} export - {1:d} : {2}", pFormatName, rc, mQuery.GetErrorMessage());
+        return removePartialFile(ExportStatus::Failed);
+    }
+
+    if (!file.Close()) {
+        pLogger->error("Error when writing the {0} file at specified location {1}", pFormatName, mOptions.FilePath);
+        return removePartialFile(ExportStatus::Failed);
+    }
+
+    /* the watermark only moves once the delta is safely on disk, a failed export is simply covered again next time */
+    if (!mQuery.RecordWatermark()) {
+        std::remove(mOptions.FilePath.c_str());
+        return ExportStatus::Failed;
+    }
+
+    if (progressCallback) {
+        progressCallback(rowCount);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    double rowsPerSecond = elapsed.count() > 0.0 ? rowCount / elapsed.count() : 0.0;
+    pLogger->info("Exported {0:d} rows ({1:d} bytes, {2:d} on disk) to {3} in {4:.3f}s - {5:.0f} rows/s",
+        rowCount,
+        file.GetBytesWritten(),
+        file.GetFileBytesWritten(),
+        mOptions.FilePath,
+        elapsed.count(),
+        rowsPerSecond);
+
+    return ExportStatus::Completed;
+}
+
+void QueryExporter::WriteHeader(BufferedFileWriter& /*writer*/)
+{
+}
+} // namespace app::svc
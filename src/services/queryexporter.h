@@ -0,0 +1,66 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "bufferedfilewriter.h"
+#include "exporter.h"
+#include "exportoptions.h"
+#include "exportquery.h"
+
+namespace app::svc
+{
+/*
+ * Drives an export query into a buffered (optionally compressed) file, independent of the output format.
+ * Opening the file, stepping the query, progress and cancellation, removing a partial file, recording the watermark
+ * and logging the throughput all live here, so a format only supplies its header and the formatting of one row.
+ */
+class QueryExporter : public IExporter
+{
+public:
+    virtual ~QueryExporter() = default;
+
+    long long EstimateRowCount() override;
+    ExportStatus ExportData(ExportProgressCallback progressCallback = nullptr) override;
+
+protected:
+    QueryExporter(std::shared_ptr<spdlog::logger> logger,
+        const ExportOptions& options,
+        const std::string& watermarkName,
+        ExportColumnPlan columnPlan,
+        const char* formatName);
+
+    /* Only called when the options ask for a header, formats without one keep the default */
+    virtual void WriteHeader(BufferedFileWriter& writer);
+    virtual void WriteRow(BufferedFileWriter& writer, sqlite3_stmt* statement) = 0;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    ExportOptions mOptions;
+    ExportQuery mQuery;
+
+private:
+    /* Used in log messages, e.g. "CSV" */
+    const char* pFormatName;
+};
+} // namespace app::svc
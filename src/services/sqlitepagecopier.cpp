@@ -0,0 +1,89 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "sqlitepagecopier.h"
+
+#include <algorithm>
+
+namespace app::svc
+{
+SqlitePageCopier::SqlitePageCopier(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+bool SqlitePageCopier::Copy(sqlite3* source, sqlite3* destination, BackupProgressCallback progressCallback)
+{
+    auto state = std::unique_ptr<sqlite3_backup, decltype(&sqlite3_backup_finish)>(
+        sqlite3_backup_init(destination, "main", source, "main"), sqlite3_backup_finish);
+
+    if (!state) {
+        pLogger->error("Error occured when starting database copy - {0:d} : {1}",
+            sqlite3_errcode(destination),
+            sqlite3_errmsg(destination));
+        return false;
+    }
+
+    int rc = SQLITE_OK;
+    int busyRetries = 0;
+    int backoffMilliseconds = InitialBackoffMilliseconds;
+    while (true) {
+        rc = sqlite3_backup_step(state.get(), PagesPerStep);
+        if (rc == SQLITE_DONE) {
+            break;
+        }
+
+        if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+            if (++busyRetries > MaxBusyRetries) {
+                break;
+            }
+            sqlite3_sleep(backoffMilliseconds);
+            backoffMilliseconds = std::min(backoffMilliseconds * 2, MaxBackoffMilliseconds);
+            continue;
+        }
+
+        if (rc != SQLITE_OK) {
+            break;
+        }
+
+        busyRetries = 0;
+        backoffMilliseconds = InitialBackoffMilliseconds;
+
+        if (progressCallback &&
+            !progressCallback(sqlite3_backup_remaining(state.get()), sqlite3_backup_pagecount(state.get()))) {
+            pLogger->info("Database copy cancelled");
+            return false;
+        }
+    }
+
+    /* finishing releases the source read lock and reports any error the last step left behind */
+    int finishRc = sqlite3_backup_finish(state.release());
+    if (rc != SQLITE_DONE || finishRc != SQLITE_OK) {
+        pLogger->error("Error occured when running database copy - {0:d} : {1}",
+            rc != SQLITE_DONE ? rc : finishRc,
+            sqlite3_errmsg(destination));
+        return false;
+    }
+
+    if (progressCallback) {
+        progressCallback(0, 0);
+    }
+    return true;
+}
+} // namespace app::svc
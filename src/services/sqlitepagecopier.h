@@ -0,0 +1,58 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+#include <sqlite3.h>
+
+namespace app::svc
+{
+/* Receives the pages still to copy and the database page count, returning false cancels the copy */
+using BackupProgressCallback = std::function<bool(int remainingPages, int pageCount)>;
+
+/*
+ * Copies one database into another with the online backup API, used both to back up and to restore.
+ * Pages are copied in bounded steps, so other connections only wait for one step at a time, and a busy or
+ * locked database is retried with a growing sqlite3_sleep instead of spinning. The destination is written in
+ * a single transaction, so a copy that fails or is cancelled partway leaves it as it was.
+ */
+class SqlitePageCopier final
+{
+public:
+    SqlitePageCopier() = delete;
+    SqlitePageCopier(std::shared_ptr<spdlog::logger> logger);
+    ~SqlitePageCopier() = default;
+
+    bool Copy(sqlite3* source, sqlite3* destination, BackupProgressCallback progressCallback);
+
+private:
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    /* 256 pages is 1 MB with the default 4 KB page size */
+    static constexpr int PagesPerStep = 256;
+    static constexpr int InitialBackoffMilliseconds = 10;
+    static constexpr int MaxBackoffMilliseconds = 250;
+    /* consecutive busy or locked steps before the copy gives up, roughly 20 seconds at the longest backoff */
+    static constexpr int MaxBusyRetries = 80;
+};
+} // namespace app::svc
@@ -0,0 +1,140 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "weekcache.h"
+
+namespace app::svc
+{
+WeekCache::WeekCache(std::size_t capacity)
+    : mCapacity(capacity)
+    , mRecentlyUsed()
+    , mWeeks()
+    , mGeneration(0)
+    , mTaskItemData()
+    , mDataVersion(0)
+    , mMutex()
+{
+    mDataVersion = mTaskItemData.GetDataVersion();
+}
+
+std::shared_ptr<WeekResult> WeekCache::Load(common::CivilDate mondayDate)
+{
+    auto week = std::make_shared<WeekResult>();
+    int daysInWeek = static_cast<int>(week->DayDurations.size());
+
+    data::TaskItemData taskItemData;
+    week->TaskItems = taskItemData.GetByWeek(mondayDate, mondayDate.AddDays(daysInWeek - 1));
+
+    for (const auto& taskItem : week->TaskItems) {
+        int dayIndex = common::CivilDate::Parse(taskItem->GetTask()->GetTaskDate()) - mondayDate;
+        if (dayIndex < 0 || dayIndex >= daysInWeek) {
+            continue;
+        }
+
+        common::Duration duration = taskItem->GetDuration();
+        week->DayDurations[dayIndex] += duration;
+        week->TotalDuration += duration;
+    }
+
+    return week;
+}
+
+std::shared_ptr<const WeekResult> WeekCache::Get(common::CivilDate mondayDate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iterator = mWeeks.find(mondayDate);
+    if (iterator == mWeeks.end()) {
+        return nullptr;
+    }
+
+    mRecentlyUsed.splice(mRecentlyUsed.begin(), mRecentlyUsed, iterator->second.second);
+    return iterator->second.first;
+}
+
+void WeekCache::Put(common::CivilDate mondayDate, std::shared_ptr<const WeekResult> week, std::uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (generation != mGeneration) {
+        return;
+    }
+
+    auto iterator = mWeeks.find(mondayDate);
+    if (iterator != mWeeks.end()) {
+        iterator->second.first = week;
+        mRecentlyUsed.splice(mRecentlyUsed.begin(), mRecentlyUsed, iterator->second.second);
+        return;
+    }
+
+    mRecentlyUsed.push_front(mondayDate);
+    mWeeks[mondayDate] = std::make_pair(week, mRecentlyUsed.begin());
+
+    while (mWeeks.size() > mCapacity) {
+        mWeeks.erase(mRecentlyUsed.back());
+        mRecentlyUsed.pop_back();
+    }
+}
+
+bool WeekCache::Contains(common::CivilDate mondayDate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return mWeeks.find(mondayDate) != mWeeks.end();
+}
+
+void WeekCache::Invalidate(common::CivilDate mondayDate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iterator = mWeeks.find(mondayDate);
+    if (iterator != mWeeks.end()) {
+        mRecentlyUsed.erase(iterator->second.second);
+        mWeeks.erase(iterator);
+    }
+
+    mGeneration++;
+}
+
+void WeekCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mWeeks.clear();
+    mRecentlyUsed.clear();
+
+    mGeneration++;
+}
+
+void WeekCache::ClearIfDataVersionChanged()
+{
+    int dataVersion = mTaskItemData.GetDataVersion();
+    if (dataVersion != mDataVersion) {
+        mDataVersion = dataVersion;
+        Clear();
+    }
+}
+
+std::uint64_t WeekCache::GetGeneration()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return mGeneration;
+}
+} // namespace app::svc
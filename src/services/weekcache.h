@@ -0,0 +1,85 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2023  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/civildate.h"
+#include "../common/duration.h"
+#include "../data/taskitemdata.h"
+#include "../models/taskitemmodel.h"
+
+namespace app::svc
+{
+struct WeekResult {
+    std::vector<std::unique_ptr<model::TaskItemModel>> TaskItems;
+    std::array<common::Duration, 7> DayDurations;
+    common::Duration TotalDuration;
+};
+
+/*
+ * Least recently used cache of loaded weeks keyed by the week's Monday.
+ * Entries are shared with the prefetch thread, so every member locks before touching the cache.
+ */
+class WeekCache final
+{
+public:
+    WeekCache() = delete;
+    WeekCache(std::size_t capacity);
+    WeekCache(const WeekCache&) = delete;
+    ~WeekCache() = default;
+
+    WeekCache& operator=(const WeekCache&) = delete;
+
+    static std::shared_ptr<WeekResult> Load(common::CivilDate mondayDate);
+
+    std::shared_ptr<const WeekResult> Get(common::CivilDate mondayDate);
+    void Put(common::CivilDate mondayDate, std::shared_ptr<const WeekResult> week, std::uint64_t generation);
+    bool Contains(common::CivilDate mondayDate);
+
+    void Invalidate(common::CivilDate mondayDate);
+    void Clear();
+    void ClearIfDataVersionChanged();
+
+    std::uint64_t GetGeneration();
+
+private:
+    using Entry = std::pair<std::shared_ptr<const WeekResult>, std::list<common::CivilDate>::iterator>;
+
+    std::size_t mCapacity;
+    std::list<common::CivilDate> mRecentlyUsed;
+    std::unordered_map<common::CivilDate, Entry> mWeeks;
+
+    /* Bumped on every clear so results loaded before an invalidation are never stored */
+    std::uint64_t mGeneration;
+
+    /* Only commits made through other connections change data_version on this one */
+    data::TaskItemData mTaskItemData;
+    int mDataVersion;
+
+    std::mutex mMutex;
+};
+} // namespace app::svc
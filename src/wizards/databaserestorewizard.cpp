@@ -24,13 +24,14 @@
 #include <wx/file.h>
 #include <wx/filefn.h>
 #include <wx/filename.h>
-#include <wx/regex.h>
 #include <wx/stdpaths.h>
 
 #include "../config/configurationprovider.h"
-#include "../database/sqliteconnectionfactory.h"
-#include "../database/sqliteconnection.h"
-#include "../database/connectionprovider.h"
+#include "../services/backupcatalog.h"
+#include "../services/databaserestore.h"
+
+wxDEFINE_EVENT(DATABASE_RESTORE_THREAD_PROGRESS, wxThreadEvent);
+wxDEFINE_EVENT(DATABASE_RESTORE_THREAD_COMPLETED, wxThreadEvent);
 
 namespace app::wizard
 {
@@ -50,7 +51,7 @@ DatabaseRestoreWizard::DatabaseRestoreWizard(frm::MainFrame* frame,
     , bRestoreWithNoPreviousFileExisting(restoreWithNoPreviousFileExisting)
 {
     pPage1 = new DatabaseRestoreWelcomePage(this);
-    auto page2 = new SelectDatabaseVersionPage(this);
+    auto page2 = new SelectDatabaseVersionPage(this, pLogger);
     auto page3 = new DatabaseRestoredPage(this, pLogger);
 
     wxWizardPageSimple::Chain(pPage1, page2);
@@ -114,9 +115,11 @@ void DatabaseRestoreWelcomePage::CreateControls()
     SetSizerAndFit(mainSizer);
 }
 
-SelectDatabaseVersionPage::SelectDatabaseVersionPage(DatabaseRestoreWizard* parent)
+SelectDatabaseVersionPage::SelectDatabaseVersionPage(DatabaseRestoreWizard* parent,
+    std::shared_ptr<spdlog::logger> logger)
     : wxWizardPageSimple(parent)
     , pParent(parent)
+    , pLogger(logger)
     , pListCtrl(nullptr)
     , mSelectedIndex(-1)
 {
@@ -205,21 +208,24 @@ void SelectDatabaseVersionPage::ConfigureEventBindings()
 void SelectDatabaseVersionPage::FillControls()
 {
     const wxString backupPath = cfg::ConfigurationProvider::Get().Configuration->GetBackupPath();
-    wxArrayString files;
-    wxDir::GetAllFiles(backupPath, &files, wxEmptyString, wxDIR_FILES);
+    svc::BackupCatalog backupCatalog(pLogger, backupPath.ToStdString());
 
     int listIndex = 0;
     int columnIndex = 0;
-    for (const auto& file : files) {
-        wxRegEx dateRegex(wxT("([0-9]{4}-[0-9]{2}-[0-9]{2})"));
-        if (dateRegex.IsValid()) {
-            if (dateRegex.Matches(file)) {
-                wxFileName filename(file);
-                auto dateComponent = dateRegex.GetMatch(file, 0);
-                listIndex = pListCtrl->InsertItem(columnIndex++, filename.GetFullName());
-                pListCtrl->SetItem(listIndex, columnIndex++, dateComponent);
-            }
+    for (const auto& entry : backupCatalog.GetEntries()) {
+        /* damaged backups are left out rather than failing partway through the restore */
+        if (entry.Verification == svc::BackupVerification::Failed) {
+            continue;
         }
+
+        /* the catalog can outlive a backup someone deleted by hand */
+        if (!wxFileExists(wxString::Format(wxT("%s\\%s"), backupPath, entry.FileName))) {
+            continue;
+        }
+
+        auto backupDate = wxDateTime(static_cast<time_t>(entry.Timestamp)).FormatISODate();
+        listIndex = pListCtrl->InsertItem(columnIndex++, entry.FileName);
+        pListCtrl->SetItem(listIndex, columnIndex++, backupDate);
         columnIndex = 0;
     }
 }
@@ -243,8 +249,57 @@ void SelectDatabaseVersionPage::OnWizardCancel(wxWizardEvent& event)
     }
 }
 
+DatabaseRestoreThread::DatabaseRestoreThread(DatabaseRestoredPage* handler,
+    std::shared_ptr<spdlog::logger> logger,
+    const std::string& backupFilePath,
+    const std::string& databaseFilePath)
+    : wxThread(wxTHREAD_DETACHED)
+    , pHandler(handler)
+    , pLogger(logger)
+    , mBackupFilePath(backupFilePath)
+    , mDatabaseFilePath(databaseFilePath)
+{
+}
+
+DatabaseRestoreThread::~DatabaseRestoreThread()
+{
+    wxCriticalSectionLocker enter(pHandler->mRestoreCriticalSection);
+    pHandler->pRestoreThread = nullptr;
+}
+
+wxThread::ExitCode DatabaseRestoreThread::Entry()
+{
+    svc::DatabaseRestore databaseRestore(pLogger);
+
+    int lastPercentage = -1;
+    bool result = databaseRestore.Execute(mBackupFilePath, mDatabaseFilePath, [&](int remainingPages, int pageCount) {
+        if (TestDestroy()) {
+            return false;
+        }
+
+        int percentage = pageCount > 0 ? (pageCount - remainingPages) * 100 / pageCount : 100;
+        if (percentage != lastPercentage) {
+            lastPercentage = percentage;
+
+            auto progressEvent = new wxThreadEvent(DATABASE_RESTORE_THREAD_PROGRESS);
+            progressEvent->SetInt(percentage);
+            wxQueueEvent(pHandler, progressEvent);
+        }
+
+        return true;
+    });
+
+    auto event = new wxThreadEvent(DATABASE_RESTORE_THREAD_COMPLETED);
+    event->SetInt(result ? 1 : 0);
+    wxQueueEvent(pHandler, event);
+
+    return (wxThread::ExitCode) 0;
+}
+
 DatabaseRestoredPage::DatabaseRestoredPage(DatabaseRestoreWizard* parent, std::shared_ptr<spdlog::logger> logger)
     : wxWizardPageSimple(parent)
+    , pRestoreThread(nullptr)
+    , mRestoreCriticalSection()
     , pParent(parent)
     , pLogger(logger)
     , pStatusInOperationLabel(nullptr)
@@ -255,6 +310,11 @@ DatabaseRestoredPage::DatabaseRestoredPage(DatabaseRestoreWizard* parent, std::s
     ConfigureEventBindings();
 }
 
+DatabaseRestoredPage::~DatabaseRestoredPage()
+{
+    RestoreThreadCleanupProcedure();
+}
+
 void DatabaseRestoredPage::CreateControls()
 {
     auto mainSizer = new wxBoxSizer(wxVERTICAL);
@@ -291,6 +351,18 @@ void DatabaseRestoredPage::ConfigureEventBindings()
         &DatabaseRestoredPage::OnWizardCancel,
         this
     );
+
+    Bind(
+        DATABASE_RESTORE_THREAD_PROGRESS,
+        &DatabaseRestoredPage::OnRestoreThreadProgress,
+        this
+    );
+
+    Bind(
+        DATABASE_RESTORE_THREAD_COMPLETED,
+        &DatabaseRestoredPage::OnRestoreThreadCompletion,
+        this
+    );
 }
 // clang-format on
 
@@ -301,71 +373,50 @@ void DatabaseRestoredPage::OnWizardPageShown(wxWizardEvent& event)
     const wxString fileToRestore = pParent->GetDatabaseFileVersionToRestore();
 
     const wxString backupPath = cfg::ConfigurationProvider::Get().Configuration->GetBackupPath();
-    const wxString dataPath = cfg::ConfigurationProvider::Get().Configuration->GetDatabasePath();
-
     auto fullBackupDatabaseFilePath = wxString::Format(wxT("%s\\%s"), backupPath, fileToRestore);
-    auto toCopyDatabaseFilePath = wxString::Format(wxT("%s\\%s"), dataPath, fileToRestore);
-
-    /* Check if the backups are in the same place as main database */
-    if (backupPath != dataPath) {
-        /* Copy selected database file to correct path */
-        bool copySuccessful = wxCopyFile(fullBackupDatabaseFilePath, toCopyDatabaseFilePath);
-        if (!copySuccessful) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to copy {0} to destination {1}",
-                fullBackupDatabaseFilePath.ToStdString(),
-                toCopyDatabaseFilePath.ToStdString());
-            return;
-        }
-    }
-
-    auto existingDatabaseFile =
+    auto databaseFilePath =
         common::GetDatabaseFilePath(cfg::ConfigurationProvider::Get().Configuration->GetDatabasePath());
 
-    /* If there is a existing 'db' file */
-    if (!pParent->IsRestoreWithNoPreviousFileExisting()) {
-        /* Terminate connection to database */
-        db::ConnectionProvider::Get().PurgeConnectionPool();
-
-        /* Rename existing file temporarily (in case any of the next steps fail) */
-        bool tmpRenameOfCurrentDatabaseFileSuccessful =
-            wxRenameFile(existingDatabaseFile, wxString::Format(wxT("%s.tmp"), existingDatabaseFile));
-        if (!tmpRenameOfCurrentDatabaseFileSuccessful) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to rename file {0} to {1}",
-                existingDatabaseFile.ToStdString(),
-                wxString::Format(wxT("%s.tmp"), existingDatabaseFile).ToStdString());
-            return;
-        }
+    /* The pages are copied on a worker thread, so the wizard stays responsive and the gauge shows real progress */
+    if (!StartDatabaseRestore(fullBackupDatabaseFilePath, databaseFilePath)) {
+        FileOperationErrorFeedback();
+        return;
     }
 
-    /* Rename the selected database file to the plain name */
-    bool renameToNewNameSuccessful = wxRenameFile(toCopyDatabaseFilePath, existingDatabaseFile);
-    if (!renameToNewNameSuccessful) {
-        FileOperationErrorFeedback();
-        pLogger->error("Failed to rename file {0} to {1}",
-            toCopyDatabaseFilePath.ToStdString(),
-            existingDatabaseFile.ToStdString());
+    EnableWizardButtons(false);
+}
+
+void DatabaseRestoredPage::OnWizardCancel(wxWizardEvent& event)
+{
+    if (IsDatabaseRestoreRunning()) {
+        wxMessageBox(wxT("Please wait for the restore to finish."),
+            common::GetProgramName(),
+            wxOK_DEFAULT | wxICON_INFORMATION);
+        event.Veto();
         return;
     }
 
-    /* If there is a existing 'db' file */
-    if (!pParent->IsRestoreWithNoPreviousFileExisting()) {
-        /* Remove the temporary file */
-        bool removeTmpDatabaseFile = wxRemoveFile(wxString::Format(wxT("%s.tmp"), existingDatabaseFile));
-        if (!removeTmpDatabaseFile) {
-            FileOperationErrorFeedback();
-            pLogger->error(
-                "Failed to remove file {0}", wxString::Format(wxT("%s.tmp"), existingDatabaseFile).ToStdString());
-            return;
-        }
+    auto userResponse = wxMessageBox(
+        wxT("Are you sure want to cancel and exit?"), common::GetProgramName(), wxICON_QUESTION | wxYES_NO);
+    if (userResponse == wxNO) {
+        event.Veto();
+    }
+}
 
-        /* Restore connection to database */
-        if (!InitializeDatabaseConnectionProvider()) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to re-initialize database connection provider");
-            return;
-        }
+void DatabaseRestoredPage::OnRestoreThreadProgress(wxThreadEvent& event)
+{
+    pGaugeCtrl->SetValue(event.GetInt());
+}
+
+void DatabaseRestoredPage::OnRestoreThreadCompletion(wxThreadEvent& event)
+{
+    EnableWizardButtons(true);
+
+    bool result = event.GetInt() == 1;
+    if (!result) {
+        FileOperationErrorFeedback();
+        pLogger->error("Failed to restore {0}", pParent->GetDatabaseFileVersionToRestore().ToStdString());
+        return;
     }
 
     /* Complete operation */
@@ -376,12 +427,63 @@ void DatabaseRestoredPage::OnWizardPageShown(wxWizardEvent& event)
     pGaugeCtrl->SetValue(100);
 }
 
-void DatabaseRestoredPage::OnWizardCancel(wxWizardEvent& event)
+bool DatabaseRestoredPage::StartDatabaseRestore(const wxString& backupFilePath, const wxString& databaseFilePath)
 {
-    auto userResponse = wxMessageBox(
-        wxT("Are you sure want to cancel and exit?"), common::GetProgramName(), wxICON_QUESTION | wxYES_NO);
-    if (userResponse == wxNO) {
-        event.Veto();
+    wxCriticalSectionLocker enter(mRestoreCriticalSection);
+    if (pRestoreThread) {
+        return false;
+    }
+
+    pRestoreThread = new DatabaseRestoreThread(
+        this, pLogger, backupFilePath.ToStdString(), databaseFilePath.ToStdString());
+    auto ret = pRestoreThread->Run();
+    if (ret != wxTHREAD_NO_ERROR) {
+        delete pRestoreThread;
+        pRestoreThread = nullptr;
+
+        pLogger->error("Failed to start the database restore thread");
+        return false;
+    }
+
+    return true;
+}
+
+bool DatabaseRestoredPage::IsDatabaseRestoreRunning()
+{
+    wxCriticalSectionLocker enter(mRestoreCriticalSection);
+    return pRestoreThread != nullptr;
+}
+
+void DatabaseRestoredPage::RestoreThreadCleanupProcedure()
+{
+    {
+        wxCriticalSectionLocker enter(mRestoreCriticalSection);
+        if (pRestoreThread) {
+            auto ret = pRestoreThread->Delete();
+            if (ret != wxTHREAD_NO_ERROR) {
+                pLogger->error("Failed to stop the database restore thread");
+            }
+        }
+    }
+
+    while (1) {
+        {
+            wxCriticalSectionLocker enter(mRestoreCriticalSection);
+            if (!pRestoreThread) {
+                break;
+            }
+        }
+        wxThread::This()->Sleep(1);
+    }
+}
+
+void DatabaseRestoredPage::EnableWizardButtons(bool enable)
+{
+    for (auto id : { wxID_BACKWARD, wxID_FORWARD, wxID_CANCEL }) {
+        auto button = pParent->FindWindow(id);
+        if (button) {
+            button->Enable(enable);
+        }
     }
 }
 
@@ -394,14 +496,4 @@ void DatabaseRestoredPage::FileOperationErrorFeedback()
     pStatusCompleteLabel->SetLabel(statusError);
     pGaugeCtrl->SetValue(100);
 }
-
-bool DatabaseRestoredPage::InitializeDatabaseConnectionProvider()
-{
-    auto sqliteConnectionFactory = std::make_shared<db::SqliteConnectionFactory>(
-        common::GetDatabaseFilePath(cfg::ConfigurationProvider::Get().Configuration->GetDatabasePath()).ToStdString());
-    auto connectionPool = std::make_unique<db::ConnectionPool<db::SqliteConnection>>(sqliteConnectionFactory, 14);
-    db::ConnectionProvider::Get().ReInitializeConnectionPool(std::move(connectionPool));
-
-    return true;
-}
 } // namespace app::wizard
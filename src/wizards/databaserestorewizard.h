@@ -20,11 +20,13 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <sqlite_modern_cpp/errors.h>
 #include <wx/wx.h>
 #include <wx/dir.h>
 #include <wx/listctrl.h>
+#include <wx/thread.h>
 #include <wx/wizard.h>
 
 #include <spdlog/spdlog.h>
@@ -33,9 +35,13 @@
 #include "../frame/mainframe.h"
 #include "../../res/database-restore-wizard.xpm"
 
+wxDECLARE_EVENT(DATABASE_RESTORE_THREAD_PROGRESS, wxThreadEvent);
+wxDECLARE_EVENT(DATABASE_RESTORE_THREAD_COMPLETED, wxThreadEvent);
+
 namespace app::wizard
 {
 class DatabaseRestoreWelcomePage;
+class DatabaseRestoredPage;
 
 class DatabaseRestoreWizard final : public wxWizard
 {
@@ -78,7 +84,7 @@ class SelectDatabaseVersionPage final : public wxWizardPageSimple
 {
 public:
     SelectDatabaseVersionPage() = delete;
-    SelectDatabaseVersionPage(DatabaseRestoreWizard* parent);
+    SelectDatabaseVersionPage(DatabaseRestoreWizard* parent, std::shared_ptr<spdlog::logger> logger);
     virtual ~SelectDatabaseVersionPage() = default;
 
     bool TransferDataFromWindow() override;
@@ -93,18 +99,43 @@ class SelectDatabaseVersionPage final : public wxWizardPageSimple
     void OnWizardCancel(wxWizardEvent& event);
 
     DatabaseRestoreWizard* pParent;
+    std::shared_ptr<spdlog::logger> pLogger;
     wxListCtrl* pListCtrl;
 
     int mSelectedIndex;
 };
 
+class DatabaseRestoreThread final : public wxThread
+{
+public:
+    DatabaseRestoreThread() = delete;
+    DatabaseRestoreThread(DatabaseRestoredPage* handler,
+        std::shared_ptr<spdlog::logger> logger,
+        const std::string& backupFilePath,
+        const std::string& databaseFilePath);
+    virtual ~DatabaseRestoreThread();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    DatabaseRestoredPage* pHandler;
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::string mBackupFilePath;
+    std::string mDatabaseFilePath;
+};
+
 class DatabaseRestoredPage final : public wxWizardPageSimple
 {
 public:
     DatabaseRestoredPage() = delete;
     DatabaseRestoredPage(DatabaseRestoreWizard* parent,
         std::shared_ptr<spdlog::logger> logger);
-    virtual ~DatabaseRestoredPage() = default;
+    virtual ~DatabaseRestoredPage();
+
+protected:
+    DatabaseRestoreThread* pRestoreThread;
+    wxCriticalSection mRestoreCriticalSection;
 
 private:
     void CreateControls();
@@ -112,10 +143,15 @@ class DatabaseRestoredPage final : public wxWizardPageSimple
 
     void OnWizardPageShown(wxWizardEvent& event);
     void OnWizardCancel(wxWizardEvent& event);
+    void OnRestoreThreadProgress(wxThreadEvent& event);
+    void OnRestoreThreadCompletion(wxThreadEvent& event);
 
-    void FileOperationErrorFeedback();
+    bool StartDatabaseRestore(const wxString& backupFilePath, const wxString& databaseFilePath);
+    bool IsDatabaseRestoreRunning();
+    void RestoreThreadCleanupProcedure();
+    void EnableWizardButtons(bool enable);
 
-    bool InitializeDatabaseConnectionProvider();
+    void FileOperationErrorFeedback();
 
     DatabaseRestoreWizard* pParent;
     std::shared_ptr<spdlog::logger> pLogger;
@@ -123,5 +159,7 @@ class DatabaseRestoredPage final : public wxWizardPageSimple
     wxStaticText* pStatusInOperationLabel;
     wxGauge* pGaugeCtrl;
     wxStaticText* pStatusCompleteLabel;
+
+    friend class DatabaseRestoreThread;
 };
 } // namespace app::wizard